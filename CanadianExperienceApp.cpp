@@ -11,6 +11,8 @@
 #include "CanadianExperienceApp.h"
 #include "MainFrame.h"
 
+#include <image-cache.h>
+
 /**
  * Initialize the application.
  * @return True if successful
@@ -52,5 +54,8 @@ bool CanadianExperienceApp::OnInit()
  */
 int CanadianExperienceApp::OnExit()
 {
+    // Bitmaps must go before the graphics renderer does
+    ImageCache::Get().Clear();
+
     return wxAppBase::OnExit();
 }
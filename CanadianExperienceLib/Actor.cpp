@@ -10,6 +10,7 @@
 #include "Actor.h"
 #include "Drawable.h"
 #include "Picture.h"
+#include "RenderCommandList.h"
 
 /**
  * Constructor
@@ -40,15 +41,66 @@ void Actor::Draw(std::shared_ptr<wxGraphicsContext> graphics)
     if (!mEnabled)
         return;
 
-    // This takes care of determining the absolute placement
-    // of all of the child drawables. We have to determine this
-    // in tree order, which may not be the order we draw.
+    Place();
+
+    for (auto drawable : mDrawablesInOrder)
+    {
+        drawable->Draw(graphics);
+    }
+}
+
+
+/**
+ * Place all of the drawables for this actor.
+ *
+ * This takes care of determining the absolute placement
+ * of all of the child drawables. We have to determine this
+ * in tree order, which may not be the order we draw.
+ */
+void Actor::Place()
+{
     if (mRoot != nullptr)
         mRoot->Place(mPosition, 0);
+}
+
+
+/**
+ * Record the drawing commands for this actor.
+ *
+ * The actor must already be placed.
+ * @param commands Command list to record into
+ * @param cull Only record drawables that intersect this
+ * rectangle. An empty rectangle records everything.
+ */
+void Actor::Record(RenderCommandList &commands, const wxRect &cull)
+{
+    if (!mEnabled)
+        return;
 
     for (auto drawable : mDrawablesInOrder)
     {
-        drawable->Draw(graphics);
+        if (cull.IsEmpty() || drawable->GetBoundingBox().Intersects(cull))
+        {
+            drawable->Record(commands);
+        }
+    }
+}
+
+
+/**
+ * Draw this actor with the software rasterizer.
+ *
+ * The actor must already be placed.
+ * @param rasterizer Rasterizer to draw into
+ */
+void Actor::Rasterize(SoftwareRasterizer &rasterizer)
+{
+    if (!mEnabled)
+        return;
+
+    for (auto drawable : mDrawablesInOrder)
+    {
+        drawable->Rasterize(rasterizer);
     }
 }
 
@@ -12,6 +12,8 @@
 
 class Drawable;
 class Picture;
+class RenderCommandList;
+class SoftwareRasterizer;
 
 /**
  * Class for actors in our drawings.
@@ -60,6 +62,9 @@ public:
 
     void SetRoot(std::shared_ptr<Drawable> root);
     void Draw(std::shared_ptr<wxGraphicsContext> graphics);
+    void Record(RenderCommandList &commands, const wxRect &cull = wxRect());
+    void Rasterize(SoftwareRasterizer &rasterizer);
+    void Place();
     std::shared_ptr<Drawable> HitTest(wxPoint pos);
     void AddDrawable(std::shared_ptr<Drawable> drawable);
 
@@ -117,6 +122,12 @@ public:
     void SetKeyframe();
     void GetKeyframe();
 
+    /**
+     * Get the drawables in drawing order
+     * @return Vector of drawables
+     */
+    const std::vector<std::shared_ptr<Drawable>> &GetDrawables() const { return mDrawablesInOrder; }
+
     /**
      * The position animation channel
      * @return Pointer to animation channel
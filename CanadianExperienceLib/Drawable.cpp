@@ -7,6 +7,7 @@
 #include "Drawable.h"
 #include "Actor.h"
 #include "Timeline.h"
+#include "RenderCommandList.h"
 
 /**
  * Constructor
@@ -60,6 +61,44 @@ void Drawable::GetKeyframe()
 }
 
 
+/**
+ * Record the commands to draw this drawable.
+ *
+ * The default records a command that calls Draw, so
+ * drawables that don't record their own commands
+ * still draw in the right order.
+ * @param commands Command list to record into
+ */
+void Drawable::Record(RenderCommandList &commands)
+{
+    commands.AddDrawable(this);
+}
+
+
+/**
+ * Draw this drawable with the software rasterizer.
+ *
+ * Drawables that have no software version draw nothing.
+ * @param rasterizer Rasterizer to draw into
+ */
+void Drawable::Rasterize(SoftwareRasterizer &rasterizer)
+{
+}
+
+
+/**
+ * Get the screen area this drawable covers once placed.
+ *
+ * The default does not know, so it claims a very large area.
+ * Changes to such a drawable repaint everything.
+ * @return Bounding box in picture coordinates
+ */
+wxRect Drawable::GetBoundingBox()
+{
+    return wxRect(-100000, -100000, 200000, 200000);
+}
+
+
 /**
  * Place this drawable relative to its parent
  *
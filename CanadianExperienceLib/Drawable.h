@@ -12,6 +12,8 @@
 
 class Actor;
 class Timeline;
+class RenderCommandList;
+class SoftwareRasterizer;
 
 /**
  * Abstract base class for drawable elements of our picture.
@@ -71,8 +73,26 @@ public:
      */
     virtual void Draw(std::shared_ptr<wxGraphicsContext> graphics) = 0;
 
+    virtual void Record(RenderCommandList &commands);
+
+    virtual void Rasterize(SoftwareRasterizer &rasterizer);
+
+    virtual wxRect GetBoundingBox();
+
     void Place(wxPoint offset, double rotate);
 
+    /**
+     * Get the position this drawable was last placed at
+     * @return Placed position in picture coordinates
+     */
+    wxPoint GetPlacedPosition() const { return mPlacedPosition; }
+
+    /**
+     * Get the rotation this drawable was last placed at
+     * @return Placed rotation in radians
+     */
+    double GetPlacedR() const { return mPlacedR; }
+
     void AddChild(std::shared_ptr<Drawable> child);
 
     /**
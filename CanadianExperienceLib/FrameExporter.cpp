@@ -0,0 +1,214 @@
+/**
+ * @file FrameExporter.cpp
+ * @author Shane Carr
+ */
+
+#include "pch.h"
+
+#include <fstream>
+#include <filesystem>
+#include <iomanip>
+#include <sstream>
+#include <thread>
+#include <wx/mstream.h>
+
+#include "FrameExporter.h"
+#include "Picture.h"
+#include "PictureFactory.h"
+#include "OffscreenRenderer.h"
+
+
+/**
+ * Constructor
+ * @param resourcesDir Directory containing the images and machine resources
+ * @param animFile Animation file to export
+ */
+FrameExporter::FrameExporter(const std::wstring &resourcesDir, const std::wstring &animFile) :
+        mResourcesDir(resourcesDir), mAnimFile(animFile)
+{
+    mThreads = std::max(int(std::thread::hardware_concurrency()), 1);
+}
+
+
+/**
+ * The filename a frame is written to
+ * @param outputDir Output directory
+ * @param frame Frame number
+ * @return Path of the frame image
+ */
+std::wstring FrameExporter::FrameFilename(const std::wstring &outputDir, int frame)
+{
+    std::wstringstream name;
+    name << outputDir << L"/frame" << std::setw(4) << std::setfill(L'0') << frame << L".png";
+    return name.str();
+}
+
+
+/**
+ * Export a range of frames
+ * @param first First frame to write
+ * @param last Last frame to write
+ * @param outputDir Directory to write the frames into
+ * @return true if every frame was written
+ */
+bool FrameExporter::Export(int first, int last, const std::wstring &outputDir)
+{
+    if (!wxFileExists(mAnimFile) || last < first)
+    {
+        return false;
+    }
+
+    mNextFrame = first;
+    mLastFrame = last;
+    mWriteFrame = first;
+    mEncoded.clear();
+    mFailed = false;
+    mError.clear();
+
+    std::thread writer(&FrameExporter::Writer, this, outputDir);
+
+    std::vector<std::thread> workers;
+    for (int i = 0; i < mThreads; i++)
+    {
+        workers.emplace_back(&FrameExporter::Worker, this);
+    }
+
+    for (auto &worker : workers)
+    {
+        worker.join();
+    }
+
+    {
+        // If a worker failed the writer may be waiting on a frame that won't come
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (mWriteFrame <= mLastFrame && mEncoded.find(mWriteFrame) == mEncoded.end())
+        {
+            mFailed = true;
+        }
+    }
+    mCondition.notify_all();
+    writer.join();
+
+    return !mFailed;
+}
+
+
+/**
+ * Worker thread. Renders and encodes blocks of frames
+ * until there are none left.
+ */
+void FrameExporter::Worker()
+{
+    std::shared_ptr<Picture> picture;
+    {
+        std::lock_guard<std::mutex> build(mBuildMutex);
+        PictureFactory factory;
+        picture = factory.Create(mResourcesDir);
+
+        // The frames are already spread over threads
+        picture->SetParallelMachines(false);
+        if (!picture->Load(mAnimFile))
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mFailed = true;
+            mError = L"Unable to load animation file " + mAnimFile;
+            mCondition.notify_all();
+            return;
+        }
+    }
+
+    OffscreenRenderer renderer(picture);
+    renderer.SetSoftware(mSoftware);
+
+    // Don't get further ahead of the writer than this, so
+    // encoded frames waiting to be written stay bounded
+    const int window = mThreads * mBlockSize * 2;
+
+    while (true)
+    {
+        int start;
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mCondition.wait(lock, [this, window] {
+                return mFailed || mNextFrame > mLastFrame || mNextFrame - mWriteFrame < window;
+            });
+
+            if (mFailed || mNextFrame > mLastFrame)
+            {
+                return;
+            }
+
+            start = mNextFrame;
+            mNextFrame = std::min(mNextFrame + mBlockSize, mLastFrame + 1);
+        }
+
+        int end = std::min(start + mBlockSize, mLastFrame + 1);
+        for (int frame = start; frame < end; frame++)
+        {
+            auto image = renderer.RenderFrame(frame);
+
+            wxMemoryOutputStream stream;
+            if (!image.SaveFile(stream, wxBITMAP_TYPE_PNG))
+            {
+                std::lock_guard<std::mutex> lock(mMutex);
+                mFailed = true;
+                mError = L"Unable to encode a frame";
+                mCondition.notify_all();
+                return;
+            }
+
+            std::vector<unsigned char> bytes(stream.GetSize());
+            stream.CopyTo(bytes.data(), bytes.size());
+
+            {
+                std::lock_guard<std::mutex> lock(mMutex);
+                mEncoded[frame] = std::move(bytes);
+            }
+            mCondition.notify_all();
+        }
+    }
+}
+
+
+/**
+ * Writer thread. Writes encoded frames to disk in frame order.
+ * @param outputDir Directory to write the frames into
+ */
+void FrameExporter::Writer(const std::wstring &outputDir)
+{
+    while (true)
+    {
+        std::vector<unsigned char> bytes;
+        int frame;
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mCondition.wait(lock, [this] {
+                return mFailed || mWriteFrame > mLastFrame || mEncoded.find(mWriteFrame) != mEncoded.end();
+            });
+
+            if (mFailed || mWriteFrame > mLastFrame)
+            {
+                return;
+            }
+
+            frame = mWriteFrame;
+            auto found = mEncoded.find(frame);
+            bytes = std::move(found->second);
+            mEncoded.erase(found);
+        }
+
+        std::ofstream file(std::filesystem::path(FrameFilename(outputDir, frame)), std::ios::binary);
+        file.write((const char *)bytes.data(), std::streamsize(bytes.size()));
+
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            if (!file)
+            {
+                mFailed = true;
+                mError = L"Unable to write " + FrameFilename(outputDir, frame);
+            }
+            mWriteFrame++;
+        }
+        mCondition.notify_all();
+    }
+}
@@ -0,0 +1,123 @@
+/**
+ * @file FrameExporter.h
+ * @author Shane Carr
+ *
+ * Multi-threaded export of animation frames to image files.
+ */
+
+#ifndef CANADIANEXPERIENCE_FRAMEEXPORTER_H
+#define CANADIANEXPERIENCE_FRAMEEXPORTER_H
+
+#include <condition_variable>
+#include <map>
+#include <mutex>
+
+/**
+ * Multi-threaded export of animation frames to image files.
+ *
+ * Each worker thread builds its own Picture with PictureFactory
+ * and renders with its own graphics context. wx reference counts
+ * pens, brushes and colours without locking, so the drawing code
+ * uses its own rather than the stock objects. The pictures are
+ * built one at a time, since building touches wx globals, and
+ * errors are passed back to the caller rather than shown by the
+ * worker. Workers take blocks of consecutive frames in increasing
+ * order, which keeps each worker's machines stepping forward. They
+ * render and PNG encode the frames and hand them to a writer
+ * thread that writes them to disk in frame order.
+ */
+class FrameExporter {
+private:
+    /// Directory containing the images and machine resources
+    std::wstring mResourcesDir;
+
+    /// Animation file each worker loads
+    std::wstring mAnimFile;
+
+    /// Number of worker threads
+    int mThreads;
+
+    /// Number of consecutive frames a worker takes at a time
+    int mBlockSize = 8;
+
+    /// Draw with the software rasterizer?
+    bool mSoftware = false;
+
+    /// Held while a worker builds and loads its picture
+    std::mutex mBuildMutex;
+
+    /// Protects everything below
+    std::mutex mMutex;
+
+    /// Signalled when a frame is encoded or written
+    std::condition_variable mCondition;
+
+    /// First frame not yet given to a worker
+    int mNextFrame = 0;
+
+    /// Last frame to export
+    int mLastFrame = 0;
+
+    /// Next frame the writer will write
+    int mWriteFrame = 0;
+
+    /// Encoded frames waiting to be written
+    std::map<int, std::vector<unsigned char>> mEncoded;
+
+    /// Set if anything failed, stops all of the threads
+    bool mFailed = false;
+
+    /// What failed, if we know
+    std::wstring mError;
+
+    void Worker();
+    void Writer(const std::wstring &outputDir);
+
+public:
+    FrameExporter(const std::wstring &resourcesDir, const std::wstring &animFile);
+
+    /// Default constructor (disabled)
+    FrameExporter() = delete;
+
+    /// Copy constructor (disabled)
+    FrameExporter(const FrameExporter &) = delete;
+
+    /// Assignment operator (disabled)
+    void operator=(const FrameExporter &) = delete;
+
+    bool Export(int first, int last, const std::wstring &outputDir);
+
+    static std::wstring FrameFilename(const std::wstring &outputDir, int frame);
+
+    /**
+     * Set the number of worker threads
+     * @param threads Thread count, at least 1
+     */
+    void SetThreads(int threads) { mThreads = std::max(threads, 1); }
+
+    /**
+     * Get the number of worker threads
+     * @return Thread count
+     */
+    int GetThreads() const { return mThreads; }
+
+    /**
+     * Set the number of consecutive frames a worker takes at a time
+     * @param frames Block size in frames, at least 1
+     */
+    void SetBlockSize(int frames) { mBlockSize = std::max(frames, 1); }
+
+    /**
+     * Choose whether frames are drawn by the software rasterizer
+     * @param software true to render in software
+     */
+    void SetSoftware(bool software) { mSoftware = software; }
+
+    /**
+     * Get what made the last export fail
+     * @return Error message, empty if unknown or none
+     */
+    const std::wstring &GetError() const { return mError; }
+};
+
+#endif //CANADIANEXPERIENCE_FRAMEEXPORTER_H
@@ -0,0 +1,98 @@
+/**
+ * @file FrameProfiler.cpp
+ * @author Shane Carr
+ */
+
+#include "pch.h"
+#include <algorithm>
+
+#include "FrameProfiler.h"
+
+/// Display names for the stages, in Stage order
+static const wchar_t *StageNames[] = {
+    L"Timeline", L"Keyframes", L"Machines", L"Place", L"Record", L"Render", L"Machine draw"
+};
+
+static_assert(std::size(StageNames) == size_t(FrameProfiler::Stage::Count), "Every stage needs a name");
+
+
+/**
+ * Record a time for a stage
+ * @param stage Stage that was timed
+ * @param time How long it took
+ */
+void FrameProfiler::Add(Stage stage, std::chrono::steady_clock::duration time)
+{
+    auto &samples = mSamples[size_t(stage)];
+    samples.times[samples.next] = std::chrono::duration<double, std::milli>(time).count();
+    samples.next = (samples.next + 1) % Window;
+    samples.count = std::min(samples.count + 1, Window);
+}
+
+
+/**
+ * Compute a percentile of the recent times for a stage
+ * @param stage Stage to measure
+ * @param percentile Percentile from 0 to 100
+ * @return Time in milliseconds, 0 if there are no samples
+ */
+double FrameProfiler::Percentile(Stage stage, double percentile) const
+{
+    const auto &samples = mSamples[size_t(stage)];
+    if (samples.count == 0)
+    {
+        return 0;
+    }
+
+    std::vector<double> times(samples.times.begin(), samples.times.begin() + samples.count);
+    auto rank = size_t(percentile / 100 * (times.size() - 1) + 0.5);
+    std::nth_element(times.begin(), times.begin() + rank, times.end());
+    return times[rank];
+}
+
+
+/**
+ * Get the median and 99th percentile for every stage
+ * @return Statistics in stage order
+ */
+std::vector<FrameProfiler::Stats> FrameProfiler::GetStats() const
+{
+    std::vector<Stats> stats;
+    for (int i = 0; i < int(Stage::Count); i++)
+    {
+        auto stage = Stage(i);
+
+        Stats stat;
+        stat.name = GetName(stage);
+        stat.count = mSamples[i].count;
+        stat.p50 = Percentile(stage, 50);
+        stat.p99 = Percentile(stage, 99);
+        stats.push_back(stat);
+    }
+
+    return stats;
+}
+
+
+/**
+ * Discard all samples
+ */
+void FrameProfiler::Clear()
+{
+    for (auto &samples : mSamples)
+    {
+        samples.count = 0;
+        samples.next = 0;
+    }
+}
+
+
+/**
+ * Get the display name of a stage
+ * @param stage Stage
+ * @return Name
+ */
+std::wstring FrameProfiler::GetName(Stage stage)
+{
+    return StageNames[size_t(stage)];
+}
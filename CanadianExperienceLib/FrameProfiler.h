@@ -0,0 +1,123 @@
+/**
+ * @file FrameProfiler.h
+ * @author Shane Carr
+ *
+ * Times the stages of setting up and drawing a frame.
+ */
+
+#ifndef CANADIANEXPERIENCE_FRAMEPROFILER_H
+#define CANADIANEXPERIENCE_FRAMEPROFILER_H
+
+#include <array>
+#include <chrono>
+
+/**
+ * Times the stages of setting up and drawing a frame.
+ *
+ * Each stage keeps a rolling window of its most recent
+ * samples, from which percentiles are computed on demand.
+ * Timing a stage is just two clock reads, so the profiler
+ * is always on.
+ */
+class FrameProfiler {
+public:
+    /// The stages of a frame we time
+    enum class Stage {
+        Timeline,       ///< Timeline::SetCurrentTime
+        Keyframes,      ///< Actor::GetKeyframe for every actor
+        Machines,       ///< Setting the machine frames
+        Place,          ///< Placing the drawables
+        Record,         ///< Recording the draw commands
+        Render,         ///< wxGraphicsContext drawing of the actors
+        MachineDraw,    ///< Drawing the machines
+        Count           ///< Number of stages
+    };
+
+    /// Number of samples kept for each stage
+    static constexpr int Window = 240;
+
+    /// Percentiles for one stage
+    struct Stats
+    {
+        /// Stage name
+        std::wstring name;
+
+        /// Number of samples in the window
+        int count = 0;
+
+        /// Median time in milliseconds
+        double p50 = 0;
+
+        /// 99th percentile time in milliseconds
+        double p99 = 0;
+    };
+
+    /**
+     * Times a stage from construction to destruction
+     */
+    class Scope
+    {
+    private:
+        /// Profiler to record into
+        FrameProfiler &mProfiler;
+
+        /// Stage being timed
+        Stage mStage;
+
+        /// When the stage started
+        std::chrono::steady_clock::time_point mStart;
+
+    public:
+        /**
+         * Constructor
+         * @param profiler Profiler to record into
+         * @param stage Stage being timed
+         */
+        Scope(FrameProfiler &profiler, Stage stage) :
+            mProfiler(profiler), mStage(stage), mStart(std::chrono::steady_clock::now()) {}
+
+        /// Destructor, records the time
+        ~Scope() { mProfiler.Add(mStage, std::chrono::steady_clock::now() - mStart); }
+
+        /// Copy constructor (disabled)
+        Scope(const Scope &) = delete;
+
+        /// Assignment operator (disabled)
+        void operator=(const Scope &) = delete;
+    };
+
+private:
+    /// Rolling window of samples for one stage
+    struct Samples
+    {
+        /// Times in milliseconds
+        std::array<double, Window> times;
+
+        /// Number of valid samples
+        int count = 0;
+
+        /// Where the next sample goes
+        int next = 0;
+    };
+
+    /// Samples for each stage
+    std::array<Samples, size_t(Stage::Count)> mSamples;
+
+public:
+    FrameProfiler() {}
+
+    /// Copy constructor (disabled)
+    FrameProfiler(const FrameProfiler &) = delete;
+
+    /// Assignment operator (disabled)
+    void operator=(const FrameProfiler &) = delete;
+
+    void Add(Stage stage, std::chrono::steady_clock::duration time);
+    double Percentile(Stage stage, double percentile) const;
+    std::vector<Stats> GetStats() const;
+    void Clear();
+
+    static std::wstring GetName(Stage stage);
+};
+
+#endif //CANADIANEXPERIENCE_FRAMEPROFILER_H
@@ -9,6 +9,7 @@
 #define CANADIANEXPERIENCE_HAROLDFACTORY_H
 
 class Actor;
+class ImageAtlas;
 
 /**
  * Factory class that builds the Harold character
@@ -18,7 +19,7 @@ private:
 
 public:
 
-    std::shared_ptr<Actor> Create(std::wstring imagesDir);
+    std::shared_ptr<Actor> Create(std::wstring imagesDir, std::shared_ptr<ImageAtlas> atlas = nullptr);
 };
 
 #endif //CANADIANEXPERIENCE_HAROLDFACTORY_H
@@ -11,6 +11,9 @@
 #include "HeadTop.h"
 #include "Actor.h"
 #include "Timeline.h"
+#include "RenderCommandList.h"
+
+#include <software-rasterizer.h>
 
 
 /**
@@ -38,6 +41,30 @@ void HeadTop::SetActor(Actor *actor)
 }
 
 
+/**
+ * Pack the head and the eye images into an atlas
+ * @param atlas Atlas to add the images to
+ */
+void HeadTop::SetAtlas(std::shared_ptr<ImageAtlas> atlas)
+{
+    ImageDrawable::SetAtlas(atlas);
+    mLeftEye.SetAtlas(atlas);
+    mRightEye.SetAtlas(atlas);
+}
+
+
+/**
+ * Draw the head and the eyes through a cache of pre-rotated sprites
+ * @param sprites Sprite cache to use
+ */
+void HeadTop::SetSpriteCache(std::shared_ptr<RotatedSpriteCache> sprites)
+{
+    ImageDrawable::SetSpriteCache(sprites);
+    mLeftEye.SetSpriteCache(sprites);
+    mRightEye.SetSpriteCache(sprites);
+}
+
+
 /**
  * Set the timeline. The tells the channel the timeline
  * @param timeline Timeline to set
@@ -135,6 +162,84 @@ void HeadTop::Draw(std::shared_ptr<wxGraphicsContext> graphics)
 }
 
 
+/**
+ * Record the commands to draw the head top
+ * @param commands Command list to record into
+ */
+void HeadTop::Record(RenderCommandList &commands)
+{
+    ImageDrawable::Record(commands);
+
+    int d2 = mInterocularDistance / 2;
+    int rightX = mEyesCenter.x - d2;
+    int leftX = mEyesCenter.x + d2;
+    int eyeY = mEyesCenter.y;
+
+    if (mLeftEye.IsLoaded() && mRightEye.IsLoaded())
+    {
+        mLeftEye.Record(commands, TransformPoint(wxPoint(leftX, eyeY)), mPlacedR);
+        mRightEye.Record(commands, TransformPoint(wxPoint(rightX, eyeY)), mPlacedR);
+    }
+    else
+    {
+        commands.AddLine(mEyebrowPen, TransformPoint(wxPoint(rightX - 10, eyeY - 16)),
+                TransformPoint(wxPoint(rightX + 4, eyeY - 18)));
+        commands.AddLine(mEyebrowPen, TransformPoint(wxPoint(leftX - 4, eyeY - 20)),
+                TransformPoint(wxPoint(leftX + 9, eyeY - 18)));
+
+        float wid = 15.0f;
+        float hit = 20.0f;
+        for (auto x : {leftX, rightX})
+        {
+            commands.AddEllipse(mEyeBrush, mEyePen,
+                    TransformPoint(wxPoint(x, eyeY)), mPlacedR, -wid/2, -hit/2, wid, hit);
+        }
+    }
+}
+
+
+/**
+ * Draw the head and face with the software rasterizer
+ * @param rasterizer Rasterizer to draw into
+ */
+void HeadTop::Rasterize(SoftwareRasterizer &rasterizer)
+{
+    ImageDrawable::Rasterize(rasterizer);
+
+    int d2 = mInterocularDistance / 2;
+    int rightX = mEyesCenter.x - d2;
+    int leftX = mEyesCenter.x + d2;
+    int eyeY = mEyesCenter.y;
+
+    if (mLeftEye.IsLoaded() && mRightEye.IsLoaded())
+    {
+        mLeftEye.Rasterize(rasterizer, TransformPoint(wxPoint(leftX, eyeY)), mPlacedR);
+        mRightEye.Rasterize(rasterizer, TransformPoint(wxPoint(rightX, eyeY)), mPlacedR);
+        return;
+    }
+
+    for (auto [p1, p2] : {std::pair(wxPoint(rightX - 10, eyeY - 16), wxPoint(rightX + 4, eyeY - 18)),
+                          std::pair(wxPoint(leftX - 4, eyeY - 20), wxPoint(leftX + 9, eyeY - 18))})
+    {
+        wxPoint t1 = TransformPoint(p1);
+        wxPoint t2 = TransformPoint(p2);
+        rasterizer.StrokeLine(t1.x, t1.y, t2.x, t2.y, 2, mEyebrowPen.GetColour());
+    }
+
+    double wid = 15;
+    double hit = 20;
+    for (auto x : {leftX, rightX})
+    {
+        wxPoint eye = TransformPoint(wxPoint(x, eyeY));
+        rasterizer.PushState();
+        rasterizer.Translate(eye.x, eye.y);
+        rasterizer.Rotate(-mPlacedR);
+        rasterizer.FillEllipse(-wid/2, -hit/2, wid, hit, mEyeBrush.GetColour());
+        rasterizer.PopState();
+    }
+}
+
+
 /**
  * Draw an eyebrow, automatically transforming the points
  *
@@ -150,8 +255,7 @@ void HeadTop::DrawEyebrow(std::shared_ptr<wxGraphicsContext> graphics,
     auto eb1 = TransformPoint(p1);
     auto eb2 = TransformPoint(p2);
 
-    wxPen eyebrowPen(*wxBLACK, 2);
-    graphics->SetPen(eyebrowPen);
+    graphics->SetPen(mEyebrowPen);
     graphics->StrokeLine(eb1.x, eb1.y, eb2.x, eb2.y);
 }
 
@@ -162,8 +266,8 @@ void HeadTop::DrawEyebrow(std::shared_ptr<wxGraphicsContext> graphics,
  * @param p1 Where to draw before transformation */
 void HeadTop::DrawEye(std::shared_ptr<wxGraphicsContext> graphics, wxPoint p1)
 {
-    graphics->SetBrush(*wxBLACK_BRUSH);
-    graphics->SetPen(*wxTRANSPARENT_PEN);
+    graphics->SetBrush(mEyeBrush);
+    graphics->SetPen(mEyePen);
 
     auto e1 = TransformPoint(p1);
 
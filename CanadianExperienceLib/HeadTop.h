@@ -26,6 +26,16 @@ private:
     RotatedBitmap mLeftEye;        ///< Bitmap for the left eye
     RotatedBitmap mRightEye;       ///< Bitmap for the right eye
 
+    /// Pen for drawn eyebrows. Not a stock pen, since pictures
+    /// on different threads may draw at the same time.
+    wxPen mEyebrowPen = wxPen(wxColour(0, 0, 0), 2);
+
+    /// Brush for drawn eyes
+    wxBrush mEyeBrush = wxBrush(wxColour(0, 0, 0));
+
+    /// Pen for drawn eyes, which have no outline
+    wxPen mEyePen = wxPen(wxColour(0, 0, 0), 1, wxPENSTYLE_TRANSPARENT);
+
     /// Channel for the head position
     AnimChannelPoint mPositionChannel;
 
@@ -39,6 +49,8 @@ public:
     bool IsMovable() override { return true; }
 
     void Draw(std::shared_ptr<wxGraphicsContext> graphics) override;
+    void Record(RenderCommandList &commands) override;
+    void Rasterize(SoftwareRasterizer &rasterizer) override;
 
     wxPoint TransformPoint(wxPoint p);
 
@@ -70,6 +82,8 @@ public:
      */
     RotatedBitmap *GetRightEye() {return &mRightEye;}
 
+    void SetAtlas(std::shared_ptr<ImageAtlas> atlas) override;
+    void SetSpriteCache(std::shared_ptr<RotatedSpriteCache> sprites) override;
     void SetActor(Actor* actor) override;
     void SetTimeline(Timeline* timeline) override;
     void SetKeyframe() override;
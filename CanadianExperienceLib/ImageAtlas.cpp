@@ -0,0 +1,140 @@
+/**
+ * @file ImageAtlas.cpp
+ * @author Shane Carr
+ */
+
+#include "pch.h"
+#include <numeric>
+
+#include "ImageAtlas.h"
+
+
+/**
+ * Constructor
+ * @param pageSize Width and height of each page in pixels
+ */
+ImageAtlas::ImageAtlas(int pageSize) : mPageSize(pageSize)
+{
+}
+
+
+/**
+ * Add an image to the atlas.
+ *
+ * Images can only be added before the atlas is built.
+ * @param image Image to add
+ * @return Entry index, or -1 if the image can't be in the atlas
+ */
+int ImageAtlas::Add(const wxImage &image)
+{
+    if (mBuilt || !image.IsOk() ||
+        image.GetWidth() + Padding > mPageSize || image.GetHeight() + Padding > mPageSize)
+    {
+        return -1;
+    }
+
+    Entry entry;
+    entry.image = image.Copy();
+    if (!entry.image.HasAlpha())
+    {
+        // Converts a mask if there is one, otherwise opaque
+        entry.image.InitAlpha();
+    }
+
+    mEntries.push_back(entry);
+    return int(mEntries.size() - 1);
+}
+
+
+/**
+ * Shelf pack the entries into page images.
+ *
+ * Entries are placed tallest first, left to right along
+ * shelves. A new shelf starts when a row is full and a new
+ * page when a page is full.
+ * @param pages Page images to fill
+ */
+void ImageAtlas::Pack(std::vector<wxImage> &pages)
+{
+    std::vector<size_t> order(mEntries.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [this](size_t a, size_t b) {
+        return mEntries[a].image.GetHeight() > mEntries[b].image.GetHeight();
+    });
+
+    int shelfX = mPageSize;
+    int shelfY = 0;
+    int shelfHeight = 0;
+
+    for (auto i : order)
+    {
+        auto &entry = mEntries[i];
+        int wid = entry.image.GetWidth();
+        int hit = entry.image.GetHeight();
+
+        if (shelfX + wid > mPageSize)
+        {
+            // Start a new shelf
+            shelfX = 0;
+            shelfY += shelfHeight;
+            shelfHeight = 0;
+        }
+
+        if (pages.empty() || shelfY + hit > mPageSize)
+        {
+            // Start a new page
+            wxImage page(mPageSize, mPageSize, true);
+            page.InitAlpha();
+            memset(page.GetAlpha(), 0, size_t(mPageSize) * mPageSize);
+            pages.push_back(page);
+            shelfX = 0;
+            shelfY = 0;
+            shelfHeight = 0;
+        }
+
+        entry.page = int(pages.size() - 1);
+        entry.rect = wxRect(shelfX, shelfY, wid, hit);
+
+        // Copy the pixel and alpha rows onto the page
+        auto &page = pages.back();
+        for (int y = 0; y < hit; y++)
+        {
+            auto dst = size_t(shelfY + y) * mPageSize + shelfX;
+            auto src = size_t(y) * wid;
+            memcpy(page.GetData() + dst * 3, entry.image.GetData() + src * 3, size_t(wid) * 3);
+            memcpy(page.GetAlpha() + dst, entry.image.GetAlpha() + src, size_t(wid));
+        }
+
+        shelfX += wid + Padding;
+        shelfHeight = std::max(shelfHeight, hit + Padding);
+
+        // The page has the pixels now
+        entry.image = wxImage();
+    }
+}
+
+
+/**
+ * Pack the images and upload one bitmap per page.
+ *
+ * Does nothing if the atlas has already been built.
+ * @param graphics Graphics context to create the bitmaps with
+ */
+void ImageAtlas::Build(std::shared_ptr<wxGraphicsContext> graphics)
+{
+    if (mBuilt)
+    {
+        return;
+    }
+
+    mBuilt = true;
+
+    std::vector<wxImage> pages;
+    Pack(pages);
+
+    for (auto &page : pages)
+    {
+        mPages.push_back(graphics->CreateBitmapFromImage(page));
+        mUploads++;
+    }
+}
@@ -0,0 +1,122 @@
+/**
+ * @file ImageAtlas.h
+ * @author Shane Carr
+ *
+ * Packs many small images into a few large bitmaps.
+ */
+
+#ifndef CANADIANEXPERIENCE_IMAGEATLAS_H
+#define CANADIANEXPERIENCE_IMAGEATLAS_H
+
+/**
+ * Packs many small images into a few large bitmaps.
+ *
+ * Images are added while the picture is being built. The
+ * first time the atlas is used to draw, the images are shelf
+ * packed into pages, and each page is uploaded as a single
+ * graphics bitmap. Drawables then draw their sub-rectangle of
+ * the shared page bitmap, clipped to their destination, instead
+ * of owning a bitmap each. No bitmap is made per image, so
+ * consecutive draws stay on the same page bitmap.
+ */
+class ImageAtlas {
+private:
+    /// An image added to the atlas
+    struct Entry
+    {
+        /// The image data, released once packed
+        wxImage image;
+
+        /// Page the image was packed into
+        int page = -1;
+
+        /// Location of the image on its page
+        wxRect rect;
+    };
+
+    /// Width and height of each page in pixels
+    int mPageSize;
+
+    /// Entries in the order they were added
+    std::vector<Entry> mEntries;
+
+    /// The uploaded page bitmaps
+    std::vector<wxGraphicsBitmap> mPages;
+
+    /// Has the atlas been packed and uploaded?
+    bool mBuilt = false;
+
+    /// Number of bitmaps created from images
+    int mUploads = 0;
+
+    void Pack(std::vector<wxImage> &pages);
+
+public:
+    /// Pixels left between packed images so filtering
+    /// does not pick up neighbouring images
+    static const int Padding = 2;
+
+    ImageAtlas(int pageSize = 2048);
+
+    /// Copy constructor (disabled)
+    ImageAtlas(const ImageAtlas &) = delete;
+
+    /// Assignment operator (disabled)
+    void operator=(const ImageAtlas &) = delete;
+
+    int Add(const wxImage &image);
+    void Build(std::shared_ptr<wxGraphicsContext> graphics);
+
+    /**
+     * Has the atlas been packed and uploaded?
+     * @return true if built
+     */
+    bool IsBuilt() const { return mBuilt; }
+
+    /**
+     * Get the page bitmap an entry was packed into
+     * @param entry Entry index returned by Add
+     * @return Page bitmap
+     */
+    const wxGraphicsBitmap &GetBitmap(int entry) const { return mPages[mEntries[entry].page]; }
+
+    /**
+     * Get the location of an entry on its page
+     * @param entry Entry index returned by Add
+     * @return Rectangle on the page
+     */
+    wxRect GetRect(int entry) const { return mEntries[entry].rect; }
+
+    /**
+     * Get the page an entry was packed into
+     * @param entry Entry index returned by Add
+     * @return Page index
+     */
+    int GetPage(int entry) const { return mEntries[entry].page; }
+
+    /**
+     * Get the size of a page
+     * @return Page width and height in pixels
+     */
+    int GetPageSize() const { return mPageSize; }
+
+    /**
+     * Number of pages in the atlas
+     * @return Page count
+     */
+    size_t GetPageCount() const { return mPages.size(); }
+
+    /**
+     * Number of images in the atlas
+     * @return Entry count
+     */
+    size_t GetEntryCount() const { return mEntries.size(); }
+
+    /**
+     * Number of bitmaps created from images by the atlas
+     * @return Upload count
+     */
+    int GetUploads() const { return mUploads; }
+};
+
+#endif //CANADIANEXPERIENCE_IMAGEATLAS_H
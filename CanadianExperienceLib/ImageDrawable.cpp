@@ -5,6 +5,11 @@
 
 #include "pch.h"
 #include "ImageDrawable.h"
+#include "RenderCommandList.h"
+#include "ImageAtlas.h"
+
+#include <image-cache.h>
+#include <software-rasterizer.h>
 
 
 /** Constructor
@@ -13,7 +18,37 @@
 ImageDrawable::ImageDrawable(const std::wstring &name, const std::wstring &filename) :
         Drawable(name)
 {
-    mImage = std::make_unique<wxImage>(filename, wxBITMAP_TYPE_ANY);
+    mImage = ImageCache::Get().Load(filename);
+}
+
+
+/**
+ * Pack this image into an atlas.
+ *
+ * After this the drawable draws from the shared atlas
+ * page instead of creating a bitmap of its own.
+ * @param atlas Atlas to add the image to
+ */
+void ImageDrawable::SetAtlas(std::shared_ptr<ImageAtlas> atlas)
+{
+    mAtlasEntry = atlas->Add(*mImage);
+    mAtlas = mAtlasEntry >= 0 ? atlas : nullptr;
+}
+
+
+/**
+ * Draw this image through a cache of pre-rotated sprites.
+ *
+ * Does nothing if the image is too large for the cache.
+ * When set, the sprite cache is used instead of any atlas.
+ * @param sprites Sprite cache to use
+ */
+void ImageDrawable::SetSpriteCache(std::shared_ptr<RotatedSpriteCache> sprites)
+{
+    if (sprites->Accepts(*mImage))
+    {
+        mSprites = sprites;
+    }
 }
 
 
@@ -23,21 +58,115 @@ ImageDrawable::ImageDrawable(const std::wstring &name, const std::wstring &filen
  */
 void ImageDrawable::Draw(std::shared_ptr<wxGraphicsContext> graphics)
 {
-    if(mBitmap.IsNull())
+    if (mSprites != nullptr)
     {
-        mBitmap = graphics->CreateBitmapFromImage(*mImage);
+        mSprite = mSprites->Get(graphics, mImage, mCenter, mPlacedR);
+        graphics->DrawBitmap(mSprite->bitmap, mPlacedPosition.x + mSprite->left,
+                mPlacedPosition.y + mSprite->top, mSprite->width, mSprite->height);
+        return;
     }
 
+    double wid = mImage->GetWidth();
+    double hit = mImage->GetHeight();
+
     graphics->PushState();
     graphics->Translate(mPlacedPosition.x, mPlacedPosition.y);
     graphics->Rotate(-mPlacedR);
-    graphics->DrawBitmap(mBitmap, -mCenter.x, -mCenter.y,
-            mImage->GetWidth(), mImage->GetHeight());
+
+    if (mAtlas != nullptr)
+    {
+        mAtlas->Build(graphics);
+        auto rect = mAtlas->GetRect(mAtlasEntry);
+        double size = mAtlas->GetPageSize();
+
+        graphics->Clip(-mCenter.x, -mCenter.y, wid, hit);
+        graphics->DrawBitmap(mAtlas->GetBitmap(mAtlasEntry),
+                -mCenter.x - rect.x, -mCenter.y - rect.y, size, size);
+    }
+    else
+    {
+        if(mBitmap.IsNull())
+        {
+            mBitmap = ImageCache::Get().GetBitmap(graphics, mImage);
+        }
+
+        graphics->DrawBitmap(mBitmap, -mCenter.x, -mCenter.y, wid, hit);
+    }
 
     graphics->PopState();
 }
 
 
+/**
+ * Record the command to draw the image drawable
+ * @param commands Command list to record into
+ */
+void ImageDrawable::Record(RenderCommandList &commands)
+{
+    if (mSprites != nullptr)
+    {
+        mSprite = mSprites->Get(commands.GetGraphics(), mImage, mCenter, mPlacedR);
+        commands.AddBitmap(mSprite->bitmap, nullptr, mPlacedPosition, 0,
+                mSprite->left, mSprite->top, mSprite->width, mSprite->height);
+        return;
+    }
+
+    if (mAtlas != nullptr)
+    {
+        mAtlas->Build(commands.GetGraphics());
+        commands.AddBitmap(mAtlas->GetBitmap(mAtlasEntry), mImage.get(), mPlacedPosition, mPlacedR,
+                -mCenter.x, -mCenter.y, mImage->GetWidth(), mImage->GetHeight(),
+                mAtlas->GetRect(mAtlasEntry), mAtlas->GetPageSize());
+        return;
+    }
+
+    if(mBitmap.IsNull())
+    {
+        mBitmap = ImageCache::Get().GetBitmap(commands.GetGraphics(), mImage);
+    }
+
+    commands.AddBitmap(mBitmap, mImage.get(), mPlacedPosition, mPlacedR,
+            -mCenter.x, -mCenter.y, mImage->GetWidth(), mImage->GetHeight());
+}
+
+
+/**
+ * Draw the image with the software rasterizer
+ * @param rasterizer Rasterizer to draw into
+ */
+void ImageDrawable::Rasterize(SoftwareRasterizer &rasterizer)
+{
+    rasterizer.PushState();
+    rasterizer.Translate(mPlacedPosition.x, mPlacedPosition.y);
+    rasterizer.Rotate(-mPlacedR);
+    rasterizer.DrawImage(mImage, -mCenter.x, -mCenter.y, mImage->GetWidth(), mImage->GetHeight());
+    rasterizer.PopState();
+}
+
+
+/**
+ * Get the screen area the placed image covers
+ * @return Bounding box in picture coordinates
+ */
+wxRect ImageDrawable::GetBoundingBox()
+{
+    int wid = mImage->GetWidth();
+    int hit = mImage->GetHeight();
+    wxPoint corners[] = {wxPoint(-mCenter.x, -mCenter.y), wxPoint(wid - mCenter.x, -mCenter.y),
+                         wxPoint(wid - mCenter.x, hit - mCenter.y), wxPoint(-mCenter.x, hit - mCenter.y)};
+
+    auto first = RotatePoint(corners[0], mPlacedR) + mPlacedPosition;
+    wxRect bounds(first, first);
+    for (auto corner : corners)
+    {
+        bounds.Union(wxRect(RotatePoint(corner, mPlacedR) + mPlacedPosition, wxSize(1, 1)));
+    }
+
+    // Allow for antialiasing and integer truncation in RotatePoint
+    return bounds.Inflate(2, 2);
+}
+
+
 /**
  * Test to see if we clicked on the image.
  * @param pos Position to test
@@ -9,6 +9,9 @@
 #define CANADIANEXPERIENCE_IMAGEDRAWABLE_H
 
 #include "Drawable.h"
+#include "RotatedSpriteCache.h"
+
+class ImageAtlas;
 
 /**
  * A drawable that displays an image
@@ -16,7 +19,7 @@
 class ImageDrawable : public Drawable {
 private:
     /// The underlying image we are drawing
-    std::unique_ptr<wxImage> mImage;
+    std::shared_ptr<const wxImage> mImage;
 
     /// The graphics bitmap we will use
     wxGraphicsBitmap mBitmap;
@@ -24,6 +27,18 @@ private:
     /// The center of the image
     wxPoint mCenter = wxPoint(0, 0);
 
+    /// Atlas the image is packed into, if any
+    std::shared_ptr<ImageAtlas> mAtlas;
+
+    /// Our entry in the atlas
+    int mAtlasEntry = -1;
+
+    /// Cache of pre-rotated copies of the image, if any
+    std::shared_ptr<RotatedSpriteCache> mSprites;
+
+    /// The sprite we last drew, kept alive until the next draw
+    std::shared_ptr<const RotatedSpriteCache::Sprite> mSprite;
+
 public:
     ImageDrawable(const std::wstring& name, const std::wstring& filename);
 
@@ -40,8 +55,14 @@ public:
     wxPoint GetCenter() const { return mCenter; }
 
     void Draw(std::shared_ptr<wxGraphicsContext> graphics) override;
+    void Record(RenderCommandList &commands) override;
+    void Rasterize(SoftwareRasterizer &rasterizer) override;
 
     bool HitTest(wxPoint pos) override;
+    wxRect GetBoundingBox() override;
+
+    virtual void SetAtlas(std::shared_ptr<ImageAtlas> atlas);
+    virtual void SetSpriteCache(std::shared_ptr<RotatedSpriteCache> sprites);
 };
 
 #endif //CANADIANEXPERIENCE_IMAGEDRAWABLE_H
@@ -0,0 +1,196 @@
+/**
+ * @file LayerCache.cpp
+ * @author Shane Carr
+ */
+
+#include "pch.h"
+#include "LayerCache.h"
+#include "Actor.h"
+#include "Drawable.h"
+#include "RenderCommandList.h"
+
+/**
+ * Mix a value into a signature
+ * @param signature Signature so far
+ * @param value Value to mix in
+ * @return New signature
+ */
+static size_t Mix(size_t signature, size_t value)
+{
+    return signature ^ (value + 0x9e3779b97f4a7c15ull + (signature << 6) + (signature >> 2));
+}
+
+
+/**
+ * Compute the pose signature of an actor.
+ *
+ * The actor must already have been placed.
+ * @param actor Actor to sign
+ * @return Signature, equal for equal poses
+ */
+size_t LayerCache::Signature(Actor *actor)
+{
+    size_t signature = Mix(0, actor->IsEnabled());
+    for (auto drawable : actor->GetDrawables())
+    {
+        // The placed position is in whole pixels, the same
+        // values the drawable is drawn at
+        auto position = drawable->GetPlacedPosition();
+        signature = Mix(signature, std::hash<int>()(position.x));
+        signature = Mix(signature, std::hash<int>()(position.y));
+        signature = Mix(signature, std::hash<double>()(drawable->GetPlacedR()));
+    }
+
+    return signature;
+}
+
+
+/**
+ * Record the drawing of all actors.
+ *
+ * Static actors are drawn from layer bitmaps, composited
+ * first if the layer is new. Moving actors are recorded
+ * normally. The actors must already have been placed.
+ * @param commands Command list to record into
+ * @param actors Actors in drawing order
+ * @param size Picture size
+ * @param cull Only record moving drawables that intersect
+ * this rectangle. An empty rectangle records everything.
+ */
+void LayerCache::Record(RenderCommandList &commands, const std::vector<std::shared_ptr<Actor>> &actors,
+        wxSize size, const wxRect &cull)
+{
+    std::vector<size_t> signatures;
+    for (auto actor : actors)
+    {
+        signatures.push_back(Signature(actor.get()));
+    }
+
+    auto isStatic = [&](size_t i) {
+        return mSignatures.size() == signatures.size() && signatures[i] == mSignatures[i];
+    };
+
+    // Commands point at the layer bitmaps, so the vector must
+    // not reallocate. Moving it into mLayers keeps its storage.
+    std::vector<Layer> layers;
+    layers.reserve(actors.size());
+
+    size_t i = 0;
+    while (i < actors.size())
+    {
+        if (!isStatic(i))
+        {
+            actors[i]->Record(commands, cull);
+            i++;
+            continue;
+        }
+
+        Layer layer;
+        layer.first = i;
+        layer.signature = 0;
+        for ( ; i < actors.size() && isStatic(i); i++)
+        {
+            layer.signature = Mix(layer.signature, signatures[i]);
+        }
+        layer.last = i;
+
+        auto found = std::find_if(mLayers.begin(), mLayers.end(), [&layer](const Layer &other) {
+            return other.first == layer.first && other.last == layer.last && other.signature == layer.signature;
+        });
+
+        if (found != mLayers.end())
+        {
+            layer.bounds = found->bounds;
+            layer.bitmap = found->bitmap;
+            mHits++;
+        }
+        else
+        {
+            Build(commands.GetGraphics(), actors, size, layer);
+        }
+
+        layers.push_back(layer);
+
+        const auto &added = layers.back();
+        if (!added.bounds.IsEmpty() && (cull.IsEmpty() || added.bounds.Intersects(cull)))
+        {
+            commands.AddBitmap(added.bitmap, nullptr, added.bounds.GetTopLeft(), 0,
+                    0, 0, added.bounds.width, added.bounds.height);
+        }
+    }
+
+    // Layers we did not use are released here
+    mLayers = std::move(layers);
+    mSignatures = std::move(signatures);
+}
+
+
+/**
+ * Composite a run of actors into a layer bitmap.
+ *
+ * The bitmap only covers the area the actors draw on.
+ * @param graphics Graphics context the layer will be drawn with
+ * @param actors All actors in drawing order
+ * @param size Picture size
+ * @param layer Layer to build
+ */
+void LayerCache::Build(std::shared_ptr<wxGraphicsContext> graphics,
+        const std::vector<std::shared_ptr<Actor>> &actors, wxSize size, Layer &layer)
+{
+    mBuilds++;
+
+    wxRect bounds;
+    for (auto i = layer.first; i < layer.last; i++)
+    {
+        if (!actors[i]->IsEnabled())
+        {
+            continue;
+        }
+
+        for (auto drawable : actors[i]->GetDrawables())
+        {
+            auto box = drawable->GetBoundingBox();
+            bounds = bounds.IsEmpty() ? box : bounds.Union(box);
+        }
+    }
+
+    layer.bounds = bounds.Intersect(wxRect(wxPoint(0, 0), size));
+    if (layer.bounds.IsEmpty() || graphics == nullptr)
+    {
+        layer.bounds = wxRect();
+        return;
+    }
+
+    wxImage image(layer.bounds.width, layer.bounds.height, true);
+    image.InitAlpha();
+    memset(image.GetAlpha(), 0, size_t(layer.bounds.width) * layer.bounds.height);
+
+    {
+        // The image is written when the context is destroyed
+        auto layerGraphics = std::shared_ptr<wxGraphicsContext>(wxGraphicsContext::Create(image));
+        layerGraphics->Translate(-layer.bounds.x, -layer.bounds.y);
+
+        RenderCommandList commands;
+        commands.Begin(layerGraphics);
+        for (auto i = layer.first; i < layer.last; i++)
+        {
+            actors[i]->Record(commands);
+        }
+        commands.Execute();
+    }
+
+    layer.bitmap = graphics->CreateBitmapFromImage(image);
+}
+
+
+/**
+ * Discard all layers.
+ *
+ * Call when something an actor draws changes in a way its
+ * pose does not show, such as loading a new picture.
+ */
+void LayerCache::Invalidate()
+{
+    mSignatures.clear();
+    mLayers.clear();
+}
@@ -0,0 +1,96 @@
+/**
+ * @file LayerCache.h
+ * @author Shane Carr
+ *
+ * Caches runs of actors that are not moving as bitmaps.
+ */
+
+#ifndef CANADIANEXPERIENCE_LAYERCACHE_H
+#define CANADIANEXPERIENCE_LAYERCACHE_H
+
+class Actor;
+class RenderCommandList;
+
+/**
+ * Caches runs of actors that are not moving as bitmaps.
+ *
+ * Each time the picture is drawn, every actor gets a pose
+ * signature computed from the placement of its drawables. An
+ * actor whose signature matches the previous draw is static.
+ * Consecutive static actors in drawing order form a layer,
+ * which is composited once into a bitmap and drawn from then
+ * on as that single bitmap. Moving actors between layers are
+ * drawn normally, so the drawing order is unchanged.
+ */
+class LayerCache {
+private:
+    /// A run of static actors composited into a bitmap
+    struct Layer
+    {
+        /// Index of the first actor in the run
+        size_t first = 0;
+
+        /// Index one past the last actor in the run
+        size_t last = 0;
+
+        /// Combined signature of the actors in the run
+        size_t signature = 0;
+
+        /// Picture area the bitmap covers
+        wxRect bounds;
+
+        /// The composited actors
+        wxGraphicsBitmap bitmap;
+    };
+
+    /// Actor signatures from the previous draw
+    std::vector<size_t> mSignatures;
+
+    /// Layers in use by the previous draw
+    std::vector<Layer> mLayers;
+
+    /// Number of layers composited
+    int mBuilds = 0;
+
+    /// Number of times a layer was reused
+    int mHits = 0;
+
+    void Build(std::shared_ptr<wxGraphicsContext> graphics,
+            const std::vector<std::shared_ptr<Actor>> &actors, wxSize size, Layer &layer);
+
+public:
+    LayerCache() {}
+
+    /// Copy constructor (disabled)
+    LayerCache(const LayerCache &) = delete;
+
+    /// Assignment operator (disabled)
+    void operator=(const LayerCache &) = delete;
+
+    void Record(RenderCommandList &commands, const std::vector<std::shared_ptr<Actor>> &actors,
+            wxSize size, const wxRect &cull = wxRect());
+
+    void Invalidate();
+
+    static size_t Signature(Actor *actor);
+
+    /**
+     * Number of layers composited into bitmaps
+     * @return Build count
+     */
+    int GetBuilds() const { return mBuilds; }
+
+    /**
+     * Number of times a composited layer was reused
+     * @return Hit count
+     */
+    int GetHits() const { return mHits; }
+
+    /**
+     * Number of layers used by the last draw
+     * @return Layer count
+     */
+    size_t GetLayerCount() const { return mLayers.size(); }
+};
+
+#endif //CANADIANEXPERIENCE_LAYERCACHE_H
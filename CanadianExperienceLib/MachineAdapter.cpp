@@ -21,12 +21,10 @@ MachineAdapter::MachineAdapter(const std::wstring& name, const std::wstring& res
 
 
 /**
- * Draw the machine at the current location
- * @param graphics Graphics object to render to
+ * Put the machine at its location in the picture
  */
-void MachineAdapter::Draw(std::shared_ptr<wxGraphicsContext> graphics)
+void MachineAdapter::PlaceMachine()
 {
-
     wxPoint location;
     if(GetName() == L"Machine1")
     {
@@ -37,11 +35,37 @@ void MachineAdapter::Draw(std::shared_ptr<wxGraphicsContext> graphics)
         location = wxPoint(600, 10);  // Right of center
     }
 
-
     mMachineSystem->SetLocation(location);
+}
+
+
+/**
+ * Draw the machine at the current location
+ * @param graphics Graphics object to render to
+ */
+void MachineAdapter::Draw(std::shared_ptr<wxGraphicsContext> graphics)
+{
+    PlaceMachine();
     mMachineSystem->DrawMachine(graphics);
 }
 
+
+/**
+ * Draw the machine at the current location with the software
+ * rasterizer. Draws nothing if the machine system can't, see
+ * CanRasterize.
+ * @param rasterizer Rasterizer to draw into
+ */
+void MachineAdapter::Rasterize(SoftwareRasterizer &rasterizer)
+{
+    auto machineRasterizer = dynamic_cast<IMachineRasterizer *>(mMachineSystem.get());
+    if(machineRasterizer != nullptr)
+    {
+        PlaceMachine();
+        machineRasterizer->RasterizeMachine(rasterizer);
+    }
+}
+
 /**
  * Test if we hit the machine
  * @param pos Position to test
@@ -63,17 +87,29 @@ bool MachineAdapter::HitTest(wxPoint pos)
  */
 void MachineAdapter::SetFrame(int frame)
 {
+    mMachineFrame = RunningFrame(frame);
+    mMachineSystem->SetMachineFrame(mMachineFrame);
+}
 
-
-    if (frame >= mStartFrame)
-    {
-        int runningFrame = frame - mStartFrame;
-        mMachineSystem->SetMachineFrame(runningFrame);
-    }
-    else
+/**
+ * How many machine frames SetFrame would have to step.
+ *
+ * A backward seek only steps from the nearest checkpoint if the
+ * machine system keeps checkpoints, see IMachineSeek. Without
+ * them it starts over from frame 0.
+ * @param frame Animation frame
+ * @return Frame count, an estimate of the work to do
+ */
+int MachineAdapter::GetPendingFrames(int frame) const
+{
+    int target = RunningFrame(frame);
+    auto seek = dynamic_cast<const IMachineSeek *>(mMachineSystem.get());
+    if (seek != nullptr)
     {
-        mMachineSystem->SetMachineFrame(0);
+        return seek->GetSeekFrames(target);
     }
+
+    return target >= mMachineFrame ? target - mMachineFrame : target;
 }
 
 /**
@@ -84,6 +120,9 @@ void MachineAdapter::SetMachineNumber(int machine)
 {
     mMachineNumber = machine;
     mMachineSystem->ChooseMachine(machine);
+
+    // A new machine starts from the beginning
+    mMachineFrame = 0;
 }
 
 /**
@@ -120,5 +159,6 @@ void MachineAdapter::ShowDialogBox(wxWindow* parent)
     {
         // The machine number updates automatically
         mMachineNumber = mMachineSystem->GetMachineNumber();
+        mMachineFrame = 0;
     }
 }
@@ -12,6 +12,8 @@
 
 // Only allowed to include the API
 #include <machine-api.h>
+#include <software-rasterizer.h>
+#include <machine-seek.h>
 
 /**
  * Class that adapts the machine system to work as a Drawable
@@ -32,9 +34,21 @@ private:
     /// The frame the machine starts running at
     int mStartFrame = 0;
 
+    /// The machine frame last set on the machine system
+    int mMachineFrame = 0;
+
+    /**
+     * Machine frame for an animation frame
+     * @param frame Animation frame
+     * @return Frames the machine has been running
+     */
+    int RunningFrame(int frame) const { return std::max(frame - mStartFrame, 0); }
+
     /// Directory containing resources for the machine
     std::wstring mResourcesDir;
 
+    void PlaceMachine();
+
 public:
     /// Constructor
     MachineAdapter(const std::wstring& name, const std::wstring& resourcesDir);
@@ -49,6 +63,14 @@ public:
     void operator=(const MachineAdapter&) = delete;
 
     void Draw(std::shared_ptr<wxGraphicsContext> graphics) override;
+    void Rasterize(SoftwareRasterizer &rasterizer) override;
+
+    /**
+     * Can the machine system draw with the software rasterizer?
+     * @return true if Rasterize draws the machine
+     */
+    bool CanRasterize() const { return dynamic_cast<IMachineRasterizer *>(mMachineSystem.get()) != nullptr; }
+
     bool HitTest(wxPoint pos) override;
     /**
  * Checks whether the machine is movable.
@@ -80,6 +102,9 @@ public:
     int GetStartFrame() const { return mStartFrame; }
 
     void SetFrame(int frame);
+
+    int GetPendingFrames(int frame) const;
+
     void XmlSave(wxXmlNode* node);
     void XmlLoad(wxXmlNode* node);
 
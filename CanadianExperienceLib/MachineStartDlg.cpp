@@ -21,8 +21,8 @@ MachineStartDlg::MachineStartDlg(wxWindow* parent, Timeline* timeline) : mTimeli
     wxXmlResource::Get()->LoadDialog(this, parent, L"MachineStartDlg");
 
     // Get the current values
-    mMachine1Start = timeline->GetMachine1StartFrame();
-    mMachine2Start = timeline->GetMachine2StartFrame();
+    mMachine1Start = timeline->GetMachineStartFrame(0);
+    mMachine2Start = timeline->GetMachineStartFrame(1);
 
     Bind(wxEVT_BUTTON, &MachineStartDlg::OnOK, this, wxID_OK);
 
@@ -52,8 +52,8 @@ void MachineStartDlg::OnOK(wxCommandEvent& event)
 
 
 
-    mTimeline->SetMachine1StartFrame(mMachine1Start);
-    mTimeline->SetMachine2StartFrame(mMachine2Start);
+    mTimeline->SetMachineStartFrame(0, mMachine1Start);
+    mTimeline->SetMachineStartFrame(1, mMachine2Start);
 
     EndModal(wxID_OK);
 }
@@ -0,0 +1,122 @@
+/**
+ * @file OffscreenRenderer.cpp
+ * @author Shane Carr
+ */
+
+#include "pch.h"
+#include "OffscreenRenderer.h"
+#include "Picture.h"
+
+#include <software-rasterizer.h>
+
+
+/**
+ * Constructor
+ * @param picture The picture to render
+ */
+OffscreenRenderer::OffscreenRenderer(std::shared_ptr<Picture> picture) : mPicture(picture)
+{
+}
+
+
+/**
+ * Destructor
+ */
+OffscreenRenderer::~OffscreenRenderer()
+{
+}
+
+
+/**
+ * Choose whether the picture is drawn by the software rasterizer
+ * @param software true to render in software
+ */
+void OffscreenRenderer::SetSoftware(bool software)
+{
+    if (!software)
+    {
+        mRasterizer.reset();
+    }
+    else if (mRasterizer == nullptr)
+    {
+        auto size = mPicture->GetSize();
+        mRasterizer = std::make_unique<SoftwareRasterizer>(size.GetWidth(), size.GetHeight());
+    }
+}
+
+
+/**
+ * Render the picture at some animation time
+ * @param time Animation time in seconds
+ * @return Image the size of the picture
+ */
+wxImage OffscreenRenderer::Render(double time)
+{
+    mPicture->SetAnimationTime(time);
+
+    if (mRasterizer != nullptr)
+    {
+        // White background, like ViewEdit
+        mRasterizer->Clear(wxColour(255, 255, 255));
+        bool machines = mPicture->Rasterize(*mRasterizer);
+
+        auto image = mRasterizer->GetImage();
+        if (!machines)
+        {
+            auto graphics = std::shared_ptr<wxGraphicsContext>(wxGraphicsContext::Create(image));
+            mPicture->DrawMachines(graphics);
+        }
+
+        return image;
+    }
+
+    auto size = mPicture->GetSize();
+    wxImage image(size.GetWidth(), size.GetHeight(), false);
+
+    // White background, like ViewEdit
+    memset(image.GetData(), 255, size_t(size.GetWidth()) * size.GetHeight() * 3);
+
+    {
+        // The image is updated when the context is destroyed
+        auto graphics = std::shared_ptr<wxGraphicsContext>(wxGraphicsContext::Create(image));
+        mPicture->Draw(graphics);
+    }
+
+    return image;
+}
+
+
+/**
+ * Render the picture at a frame of the timeline
+ * @param frame Frame number
+ * @return Image the size of the picture
+ */
+wxImage OffscreenRenderer::RenderFrame(int frame)
+{
+    return Render(double(frame) / mPicture->GetTimeline()->GetFrameRate());
+}
+
+
+/**
+ * Render the picture into a raw RGBA buffer.
+ *
+ * Rows are top to bottom, four bytes per pixel.
+ * @param time Animation time in seconds
+ * @param rgba Buffer to fill, resized as needed
+ */
+void OffscreenRenderer::RenderRGBA(double time, std::vector<unsigned char> &rgba)
+{
+    auto image = Render(time);
+    size_t pixels = size_t(image.GetWidth()) * image.GetHeight();
+    rgba.resize(pixels * 4);
+
+    const unsigned char *rgb = image.GetData();
+    const unsigned char *alpha = image.HasAlpha() ? image.GetAlpha() : nullptr;
+    for (size_t i = 0; i < pixels; i++)
+    {
+        rgba[i * 4] = rgb[i * 3];
+        rgba[i * 4 + 1] = rgb[i * 3 + 1];
+        rgba[i * 4 + 2] = rgb[i * 3 + 2];
+        rgba[i * 4 + 3] = alpha != nullptr ? alpha[i] : 255;
+    }
+}
@@ -0,0 +1,65 @@
+/**
+ * @file OffscreenRenderer.h
+ * @author Shane Carr
+ *
+ * Renders picture frames without a window.
+ */
+
+#ifndef CANADIANEXPERIENCE_OFFSCREENRENDERER_H
+#define CANADIANEXPERIENCE_OFFSCREENRENDERER_H
+
+class Picture;
+class SoftwareRasterizer;
+
+/**
+ * Renders picture frames without a window.
+ *
+ * Frames are drawn through a graphics context on an image,
+ * the same way ViewEdit draws them on the screen, so this
+ * works on machines that have no display.
+ *
+ * Optionally the picture is drawn by the software rasterizer
+ * instead. Machines whose machine system can't rasterize still
+ * go through a graphics context, see Picture::Rasterize.
+ */
+class OffscreenRenderer {
+private:
+    /// The picture we render
+    std::shared_ptr<Picture> mPicture;
+
+    /// Rasterizer for software rendering, null when drawing with wx
+    std::unique_ptr<SoftwareRasterizer> mRasterizer;
+
+public:
+    OffscreenRenderer(std::shared_ptr<Picture> picture);
+    ~OffscreenRenderer();
+
+    /// Default constructor (disabled)
+    OffscreenRenderer() = delete;
+
+    /// Copy constructor (disabled)
+    OffscreenRenderer(const OffscreenRenderer &) = delete;
+
+    /// Assignment operator (disabled)
+    void operator=(const OffscreenRenderer &) = delete;
+
+    wxImage Render(double time);
+    wxImage RenderFrame(int frame);
+    void RenderRGBA(double time, std::vector<unsigned char> &rgba);
+
+    void SetSoftware(bool software);
+
+    /**
+     * Is the picture drawn by the software rasterizer?
+     * @return true if rendering in software
+     */
+    bool IsSoftware() const { return mRasterizer != nullptr; }
+
+    /**
+     * Get the picture we render
+     * @return Picture pointer
+     */
+    std::shared_ptr<Picture> GetPicture() const { return mPicture; }
+};
+
+#endif //CANADIANEXPERIENCE_OFFSCREENRENDERER_H
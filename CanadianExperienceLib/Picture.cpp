@@ -3,12 +3,16 @@
  * @author Charles B. Owen
  */
 #include "pch.h"
+#include <thread>
 #include <wx/stdpaths.h>
 
 #include "Picture.h"
 #include "PictureObserver.h"
 #include "Actor.h"
 
+/// Machine frames a machine has to move before stepping it
+/// on a worker thread is worth starting the thread
+const int ParallelMachineFrames = 10;
 
 /**
  * Constructor
@@ -27,31 +31,60 @@ Picture::Picture()
  */
 void Picture::SetAnimationTime(double time)
 {
-    mTimeline.SetCurrentTime(time);
+    {
+        FrameProfiler::Scope scope(mProfiler, FrameProfiler::Stage::Timeline);
+        mTimeline.SetCurrentTime(time);
+    }
+
     UpdateObservers();
 
     // Update actors
-    for (auto actor : mActors)
     {
-        actor->GetKeyframe();
+        FrameProfiler::Scope scope(mProfiler, FrameProfiler::Stage::Keyframes);
+        for (auto actor : mActors)
+        {
+            actor->GetKeyframe();
+        }
     }
 
     int currentFrame = mTimeline.GetCurrentFrame();
 
-    // Get iterator to first and second machine
-    auto it = mMachines.begin();
-    if (it != mMachines.end())
+    FrameProfiler::Scope scope(mProfiler, FrameProfiler::Stage::Machines);
+
+    // Machines with a lot of catching up to do, after a scrub
+    // or seek, are independent of each other, so they all step
+    // at once and it takes as long as the slowest one
+    std::vector<size_t> busy;
+    for (size_t i = 0; i < mMachines.size(); i++)
+    {
+        mMachines[i]->SetStartFrame(mTimeline.GetMachineStartFrame(i));
+        if (mParallelMachines && mMachines[i]->GetPendingFrames(currentFrame) >= ParallelMachineFrames)
+        {
+            busy.push_back(i);
+        }
+    }
+
+    // The first busy machine stays on this thread with the rest
+    std::vector<std::thread> workers;
+    std::vector<bool> onWorker(mMachines.size(), false);
+    for (size_t i = 1; i < busy.size(); i++)
+    {
+        onWorker[busy[i]] = true;
+        workers.emplace_back([machine = mMachines[busy[i]], currentFrame] { machine->SetFrame(currentFrame); });
+    }
+
+    for (size_t i = 0; i < mMachines.size(); i++)
     {
-        // First machine
-        (*it)->SetStartFrame(mTimeline.GetMachine1StartFrame());
-        (*it)->SetFrame(currentFrame);
-        ++it;
+        if (!onWorker[i])
+        {
+            mMachines[i]->SetFrame(currentFrame);
+        }
     }
-    if (it != mMachines.end())
+
+    // Every machine is where it should be before anything is drawn
+    for (auto &worker : workers)
     {
-        // Second machine
-        (*it)->SetStartFrame(mTimeline.GetMachine2StartFrame());
-        (*it)->SetFrame(currentFrame);
+        worker.join();
     }
 }
 
@@ -100,21 +133,95 @@ void Picture::UpdateObservers()
 /**
  * Draw this picture on a device context
  * @param graphics The device context to draw on
+ * @param cull Only draw actor drawables that intersect this
+ * rectangle. An empty rectangle draws everything.
  */
-void Picture::Draw(std::shared_ptr<wxGraphicsContext> graphics)
+void Picture::Draw(std::shared_ptr<wxGraphicsContext> graphics, const wxRect &cull)
 {
-    for (auto actor : mActors)
     {
-        actor->Draw(graphics);
+        FrameProfiler::Scope scope(mProfiler, FrameProfiler::Stage::Place);
+        for (auto actor : mActors)
+        {
+            actor->Place();
+        }
     }
 
-    // Draw the machines
+    // Actors record their drawing, then it is replayed
+    // with redundant state changes removed. Actors that
+    // have not moved since the last draw come from layers.
+    {
+        FrameProfiler::Scope scope(mProfiler, FrameProfiler::Stage::Record);
+        mCommands.Begin(graphics);
+        mLayers.Record(mCommands, mActors, mSize, cull);
+    }
+
+    {
+        FrameProfiler::Scope scope(mProfiler, FrameProfiler::Stage::Render);
+        mCommands.Execute();
+    }
+
+    DrawMachines(graphics);
+}
+
+
+/**
+ * Draw the machines in this picture
+ * @param graphics The graphics context to draw on
+ */
+void Picture::DrawMachines(std::shared_ptr<wxGraphicsContext> graphics)
+{
+    FrameProfiler::Scope scope(mProfiler, FrameProfiler::Stage::MachineDraw);
     for (auto machine : mMachines)
     {
         machine->Draw(graphics);
     }
 }
 
+
+/**
+ * Draw this picture with the software rasterizer.
+ *
+ * The machines are drawn too if every machine system can
+ * rasterize. Otherwise none are, so they can be drawn in
+ * order afterwards with DrawMachines.
+ * @param rasterizer Rasterizer to draw into
+ * @return true if the machines were drawn
+ */
+bool Picture::Rasterize(SoftwareRasterizer &rasterizer)
+{
+    {
+        FrameProfiler::Scope scope(mProfiler, FrameProfiler::Stage::Place);
+        for (auto actor : mActors)
+        {
+            actor->Place();
+        }
+    }
+
+    {
+        FrameProfiler::Scope scope(mProfiler, FrameProfiler::Stage::Render);
+        for (auto actor : mActors)
+        {
+            actor->Rasterize(rasterizer);
+        }
+    }
+
+    for (auto machine : mMachines)
+    {
+        if (!machine->CanRasterize())
+        {
+            return false;
+        }
+    }
+
+    FrameProfiler::Scope scope(mProfiler, FrameProfiler::Stage::MachineDraw);
+    for (auto machine : mMachines)
+    {
+        machine->Rasterize(rasterizer);
+    }
+
+    return true;
+}
+
 /**
  * Add an actor to this drawable.
  * @param actor Actor to add
@@ -123,6 +230,7 @@ void Picture::AddActor(std::shared_ptr<Actor> actor)
 {
     mActors.push_back(actor);
     actor->SetPicture(this);
+    mLayers.Invalidate();
 }
 
 
@@ -156,15 +264,18 @@ void Picture::Save(const wxString& filename)
 
 /**
 * Load a picture animation from a file
+*
+* Failure is left to the caller to report, since pictures
+* may be loaded on worker threads.
 * @param filename file to load from
+* @return true if the file was loaded
 */
-void Picture::Load(const wxString& filename)
+bool Picture::Load(const wxString& filename)
 {
     wxXmlDocument xmlDoc;
     if(!xmlDoc.Load(filename))
     {
-        wxMessageBox(L"Unable to load Animation file");
-        return;
+        return false;
     }
 
     // Get the XML document root node
@@ -172,6 +283,7 @@ void Picture::Load(const wxString& filename)
 
     // Load the animation from the XML
     mTimeline.Load(root);
+    mLayers.Invalidate();
 
     //
     // It is possible to load attributes from the root node here
@@ -180,6 +292,7 @@ void Picture::Load(const wxString& filename)
 
     SetAnimationTime(0);
     UpdateObservers();
+    return true;
 }
 
 /**
@@ -10,9 +10,13 @@
 
 #include "Timeline.h"
 #include "MachineAdapter.h"
+#include "RenderCommandList.h"
+#include "LayerCache.h"
+#include "FrameProfiler.h"
 
 class PictureObserver;
 class Actor;
+class SoftwareRasterizer;
 
 /**
  *  Class that represents our animation picture
@@ -35,9 +39,21 @@ private:
     /// The animation timeline
     Timeline mTimeline;
 
+    /// Commands recorded for the frame being drawn
+    RenderCommandList mCommands;
+
+    /// Bitmaps of the actors that are not moving
+    LayerCache mLayers;
+
+    /// Times the stages of each frame
+    FrameProfiler mProfiler;
+
     ///resource directory
     std::wstring mResourcesDir;
 
+    /// Step machines that have catching up to do on worker threads?
+    bool mParallelMachines = true;
+
 public:
     Picture();
 
@@ -69,10 +85,25 @@ public:
      */
     Timeline *GetTimeline() {return &mTimeline;}
 
+    /**
+     * Get the profiler that times each frame
+     * @return Pointer to the profiler
+     */
+    FrameProfiler *GetProfiler() {return &mProfiler;}
+
+    /**
+     * Set whether machines catch up on worker threads. Turn it
+     * off when pictures are already being run on several threads.
+     * @param parallel true to step machines concurrently
+     */
+    void SetParallelMachines(bool parallel) {mParallelMachines = parallel;}
+
     void AddObserver(PictureObserver *observer);
     void RemoveObserver(PictureObserver *observer);
     void UpdateObservers();
-    void Draw(std::shared_ptr<wxGraphicsContext> graphics);
+    void Draw(std::shared_ptr<wxGraphicsContext> graphics, const wxRect &cull = wxRect());
+    void DrawMachines(std::shared_ptr<wxGraphicsContext> graphics);
+    bool Rasterize(SoftwareRasterizer &rasterizer);
 
     void AddActor(std::shared_ptr<Actor> actor);
 
@@ -145,7 +176,7 @@ public:
 
     double GetAnimationTime();
 
-    void Load(const wxString& filename);
+    bool Load(const wxString& filename);
 
     void Save(const wxString& filename);
 };
@@ -13,6 +13,8 @@
 #include "Actor.h"
 #include "ImageDrawable.h"
 #include "MachineAdapter.h"
+#include "ImageAtlas.h"
+#include "RotatedSpriteCache.h"
 
 
 /// Directory within resources that contains the images.
@@ -30,6 +32,10 @@ std::shared_ptr<Picture> PictureFactory::Create(std::wstring resourcesDir)
 
     auto picture = std::make_shared<Picture>();
 
+    // All of the actor images are packed into this
+    // atlas the first time the picture is drawn
+    auto atlas = std::make_shared<ImageAtlas>();
+
     // Create the background and add it
     auto background = std::make_shared<Actor>(L"Background");
     background->SetClickable(false);
@@ -38,11 +44,12 @@ std::shared_ptr<Picture> PictureFactory::Create(std::wstring resourcesDir)
             std::make_shared<ImageDrawable>(L"Background", imagesDir + L"/Background2.png");
     background->AddDrawable(backgroundI);
     background->SetRoot(backgroundI);
+    backgroundI->SetAtlas(atlas);
     picture->AddActor(background);
 
     // Create and add Harold
     HaroldFactory haroldFactory;
-    auto harold = haroldFactory.Create(imagesDir);
+    auto harold = haroldFactory.Create(imagesDir, atlas);
 
     // This is where Harold will start out.
     harold->SetPosition(wxPoint(150, 600));
@@ -50,11 +57,24 @@ std::shared_ptr<Picture> PictureFactory::Create(std::wstring resourcesDir)
 
     // Create and add Sparty
     SpartyFactory spartyFactory;
-    auto sparty = spartyFactory.Create(imagesDir);
+    auto sparty = spartyFactory.Create(imagesDir, atlas);
 
     sparty->SetPosition(wxPoint(650, 620));
     picture->AddActor(sparty);
 
+    // Small rotating images draw from pre-rotated copies
+    auto sprites = std::make_shared<RotatedSpriteCache>();
+    for (auto actor : {harold, sparty})
+    {
+        for (auto drawable : actor->GetDrawables())
+        {
+            if (auto image = std::dynamic_pointer_cast<ImageDrawable>(drawable))
+            {
+                image->SetSpriteCache(sprites);
+            }
+        }
+    }
+
     // Create and add the machine
     auto machine = std::make_shared<MachineAdapter>(L"Machine1", resourcesDir);
     machine->SetPosition(wxPoint(0, 0));  // Set initial position
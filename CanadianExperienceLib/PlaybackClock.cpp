@@ -0,0 +1,137 @@
+/**
+ * @file PlaybackClock.cpp
+ * @author Shane Carr
+ */
+
+#include "pch.h"
+#include <algorithm>
+#include <numeric>
+
+#include "PlaybackClock.h"
+
+/// Milliseconds as a floating point duration
+using Milliseconds = std::chrono::duration<double, std::milli>;
+
+/**
+ * Start playback and reset the statistics
+ * @param frame Frame to start from, presented immediately
+ * @param frameRate Frames per second
+ * @param now The current time
+ */
+void PlaybackClock::Start(int frame, double frameRate, Clock::time_point now)
+{
+    mFrameRate = frameRate;
+    mStartFrame = frame;
+    mStart = now;
+    mFrame = frame;
+    mLastPresent = now;
+    mLateness.clear();
+    mDropped = 0;
+}
+
+
+/**
+ * When a frame is due
+ * @param frame Frame number
+ * @return Deadline for the frame
+ */
+PlaybackClock::Clock::time_point PlaybackClock::Deadline(int frame) const
+{
+    std::chrono::duration<double> offset((frame - mStartFrame) / mFrameRate);
+    return mStart + std::chrono::duration_cast<Clock::duration>(offset);
+}
+
+
+/**
+ * Move to the latest frame that is due.
+ *
+ * Any frames between the last one presented and the one
+ * returned were missed and are counted as dropped.
+ * @param now The current time
+ * @return Number of frames advanced, 0 if no new frame is due yet
+ */
+int PlaybackClock::Advance(Clock::time_point now)
+{
+    std::chrono::duration<double> elapsed = now - mStart;
+    int due = mStartFrame + int(elapsed.count() * mFrameRate);
+    // Guard against rounding in the conversion above
+    while (due > mStartFrame && Deadline(due) > now)
+    {
+        due--;
+    }
+
+    while (Deadline(due + 1) <= now)
+    {
+        due++;
+    }
+
+    if (due <= mFrame)
+    {
+        return 0;
+    }
+
+    int advanced = due - mFrame;
+    mDropped += advanced - 1;
+    mFrame = due;
+    mLastPresent = now;
+    mLateness.push_back(Milliseconds(now - Deadline(due)).count());
+    return advanced;
+}
+
+
+/**
+ * How long until the next frame is due
+ * @param now The current time
+ * @return Time until the next deadline, zero if already due
+ */
+PlaybackClock::Clock::duration PlaybackClock::UntilNext(Clock::time_point now) const
+{
+    auto next = Deadline(mFrame + 1);
+    return next > now ? next - now : Clock::duration::zero();
+}
+
+
+/**
+ * Average lateness of the presented frames
+ * @return Lateness in milliseconds
+ */
+double PlaybackClock::GetAverageLateness() const
+{
+    if (mLateness.empty())
+    {
+        return 0;
+    }
+
+    return std::accumulate(mLateness.begin(), mLateness.end(), 0.0) / mLateness.size();
+}
+
+
+/**
+ * Worst lateness of the presented frames
+ * @return Lateness in milliseconds
+ */
+double PlaybackClock::GetMaxLateness() const
+{
+    if (mLateness.empty())
+    {
+        return 0;
+    }
+
+    return *std::max_element(mLateness.begin(), mLateness.end());
+}
+
+
+/**
+ * Frames per second actually presented since playback started
+ * @return Achieved frame rate
+ */
+double PlaybackClock::GetFps() const
+{
+    std::chrono::duration<double> elapsed = mLastPresent - mStart;
+    if (elapsed.count() <= 0)
+    {
+        return 0;
+    }
+
+    return mLateness.size() / elapsed.count();
+}
@@ -0,0 +1,101 @@
+/**
+ * @file PlaybackClock.h
+ * @author Shane Carr
+ *
+ * Decides which animation frame is due during playback.
+ */
+
+#ifndef CANADIANEXPERIENCE_PLAYBACKCLOCK_H
+#define CANADIANEXPERIENCE_PLAYBACKCLOCK_H
+
+#include <chrono>
+
+/**
+ * Decides which animation frame is due during playback.
+ *
+ * Frame n is due at the playback start time plus n frame
+ * periods, computed from the start each time so errors
+ * never accumulate. When we fall behind, the frames we
+ * missed are dropped rather than shown late, so playback
+ * keeps pace with the wall clock. Frames are always whole
+ * frames, so the simulation sees exactly the same frame
+ * times it would see when stepping.
+ */
+class PlaybackClock {
+public:
+    /// The clock we measure against
+    using Clock = std::chrono::steady_clock;
+
+private:
+    /// Frames per second
+    double mFrameRate = 30;
+
+    /// Frame playback started from
+    int mStartFrame = 0;
+
+    /// When playback started
+    Clock::time_point mStart;
+
+    /// Last frame presented
+    int mFrame = 0;
+
+    /// When the last frame was presented
+    Clock::time_point mLastPresent;
+
+    /// How late each presented frame was in milliseconds
+    std::vector<double> mLateness;
+
+    /// Number of frames skipped because we were behind
+    int mDropped = 0;
+
+    Clock::time_point Deadline(int frame) const;
+
+public:
+    PlaybackClock() {}
+
+    /// Copy constructor (disabled)
+    PlaybackClock(const PlaybackClock &) = delete;
+
+    /// Assignment operator (disabled)
+    void operator=(const PlaybackClock &) = delete;
+
+    void Start(int frame, double frameRate, Clock::time_point now = Clock::now());
+    int Advance(Clock::time_point now = Clock::now());
+    Clock::duration UntilNext(Clock::time_point now = Clock::now()) const;
+
+    double GetAverageLateness() const;
+    double GetMaxLateness() const;
+    double GetFps() const;
+
+    /**
+     * Get the last frame presented
+     * @return Frame number
+     */
+    int GetFrame() const { return mFrame; }
+
+    /**
+     * Get the animation time of the last frame presented
+     * @return Time in seconds
+     */
+    double GetTime() const { return mFrame / mFrameRate; }
+
+    /**
+     * How late each presented frame was
+     * @return Lateness in milliseconds, one per frame
+     */
+    const std::vector<double> &GetLateness() const { return mLateness; }
+
+    /**
+     * Number of frames skipped because we were behind
+     * @return Dropped frame count
+     */
+    int GetDroppedFrames() const { return mDropped; }
+
+    /**
+     * Number of frames presented since playback started
+     * @return Presented frame count
+     */
+    int GetPresentedFrames() const { return int(mLateness.size()); }
+};
+
+#endif //CANADIANEXPERIENCE_PLAYBACKCLOCK_H
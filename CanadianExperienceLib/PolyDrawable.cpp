@@ -5,6 +5,9 @@
 
 #include "pch.h"
 #include "PolyDrawable.h"
+#include "RenderCommandList.h"
+
+#include <software-rasterizer.h>
 
 /**
  * Constructor
@@ -16,48 +19,209 @@ PolyDrawable::PolyDrawable(const std::wstring &name) : Drawable(name)
 
 /**
  * Draw our polygon.
+ *
+ * The path is kept in local coordinates and only rebuilt
+ * when points are added. Placement is applied as a transform
+ * on the graphics context.
  * @param  graphics The graphics context to draw on
  */
 void PolyDrawable::Draw(std::shared_ptr<wxGraphicsContext> graphics)
 {
-    if(!mPoints.empty()) {
+    if(mPoints.empty())
+    {
+        return;
+    }
 
-        mPath = graphics->CreatePath();
-        mPath.MoveToPoint(RotatePoint(mPoints[0], mPlacedR) + mPlacedPosition);
-        for (auto i = 1; i<mPoints.size(); i++)
-        {
-            mPath.AddLineToPoint(RotatePoint(mPoints[i], mPlacedR) + mPlacedPosition);
-        }
-        mPath.CloseSubpath();
+    UpdatePath(graphics);
 
-        wxBrush brush(mColor);
-        graphics->SetBrush(brush);
-        graphics->FillPath(mPath);
+    graphics->PushState();
+    graphics->Translate(mPlacedPosition.x, mPlacedPosition.y);
+    graphics->Rotate(-mPlacedR);
+    graphics->SetBrush(mBrush);
+    graphics->FillPath(mPath);
+    graphics->PopState();
+}
+
+
+/**
+ * Record the command to fill our polygon
+ * @param commands Command list to record into
+ */
+void PolyDrawable::Record(RenderCommandList &commands)
+{
+    if(mPoints.empty())
+    {
+        return;
     }
 
+    UpdatePath(commands.GetGraphics());
+    UpdateEdges();
+    commands.AddFill(mPath, &mPoints, mBrush, mPlacedPosition, mPlacedR, mEdgeBounds);
+}
 
 
+/**
+ * Fill the polygon with the software rasterizer
+ * @param rasterizer Rasterizer to draw into
+ */
+void PolyDrawable::Rasterize(SoftwareRasterizer &rasterizer)
+{
+    if(mPoints.empty())
+    {
+        return;
+    }
 
-//    SolidBrush brush(mColor);
-//
-//    // Transform the points
-//    vector<Point> points;
-//    for (auto point : mPoints)
-//    {
-//        points.push_back(RotatePoint(point, mPlacedR) + mPlacedPosition);
-//    }
-//
-//    graphics->FillPolygon(&brush, &points[0], (int)points.size());
+    std::vector<wxPoint2DDouble> points(mPoints.begin(), mPoints.end());
+
+    rasterizer.PushState();
+    rasterizer.Translate(mPlacedPosition.x, mPlacedPosition.y);
+    rasterizer.Rotate(-mPlacedR);
+    rasterizer.FillPolygon(points, mColor);
+    rasterizer.PopState();
+}
+
+
+/**
+ * Build the local coordinate path if the points have changed
+ * @param graphics Graphics context to create the path with
+ */
+void PolyDrawable::UpdatePath(std::shared_ptr<wxGraphicsContext> graphics)
+{
+    if (mPathValid)
+    {
+        return;
+    }
+
+    mPath = graphics->CreatePath();
+    mPath.MoveToPoint(mPoints[0]);
+    for (auto i = 1; i<mPoints.size(); i++)
+    {
+        mPath.AddLineToPoint(mPoints[i]);
+    }
+    mPath.CloseSubpath();
+    mPathValid = true;
 }
 
 
 /** Test to see if we hit this object with a mouse click
+ *
+ * This is a geometric even-odd test of the pixel center
+ * against the placed vertices. They are placed with the same
+ * transform Draw uses, so it gives the same answer as the drawn
+ * path but does not require the polygon to have been drawn.
  * @param pos Click position
  * @return true it hit
  */
 bool PolyDrawable::HitTest(wxPoint pos)
 {
-    return mPath.Contains(pos.x, pos.y);
+    UpdateEdges();
+    if (mEdgeX0.empty() || !mEdgeBounds.Contains(pos))
+    {
+        return false;
+    }
+
+    const double x = pos.x + 0.5;
+    const double y = pos.y + 0.5;
+    const auto numEdges = mEdgeX0.size();
+    const double *x0 = mEdgeX0.data();
+    const double *y0 = mEdgeY0.data();
+    const double *y1 = mEdgeY1.data();
+    const double *slope = mEdgeSlope.data();
+
+    // Count the edges crossed by a ray to the right of the point.
+    // No branches in the loop so the compiler can vectorize it.
+    int crossings = 0;
+    for (size_t i = 0; i < numEdges; i++)
+    {
+        bool straddles = (y0[i] > y) != (y1[i] > y);
+        bool left = x < x0[i] + (y - y0[i]) * slope[i];
+        crossings += int(straddles & left);
+    }
+
+    return (crossings & 1) != 0;
+}
+
+
+/**
+ * Get the screen area the placed polygon covers
+ * @return Bounding box in picture coordinates
+ */
+wxRect PolyDrawable::GetBoundingBox()
+{
+    UpdateEdges();
+    if (mPoints.empty())
+    {
+        return wxRect();
+    }
+
+    auto bounds = mEdgeBounds;
+    return bounds.Inflate(2, 2);
+}
+
+
+/**
+ * Rebuild the edge table if the points or the
+ * placement have changed since it was last built.
+ */
+void PolyDrawable::UpdateEdges()
+{
+    if (mEdgesValid && mEdgePosition == mPlacedPosition && mEdgeR == mPlacedR)
+    {
+        return;
+    }
+
+    mEdgePosition = mPlacedPosition;
+    mEdgeR = mPlacedR;
+    mEdgesValid = true;
+
+    mEdgeX0.clear();
+    mEdgeY0.clear();
+    mEdgeY1.clear();
+    mEdgeSlope.clear();
+    if (mPoints.empty())
+    {
+        return;
+    }
+
+    // Place the points the way Draw does, translating and then
+    // rotating by -mPlacedR, without rounding to whole pixels
+    double cosR = cos(mPlacedR);
+    double sinR = sin(mPlacedR);
+    std::vector<wxPoint2DDouble> placed;
+    placed.reserve(mPoints.size());
+    for (auto point : mPoints)
+    {
+        placed.emplace_back(mPlacedPosition.x + cosR * point.x + sinR * point.y,
+                mPlacedPosition.y - sinR * point.x + cosR * point.y);
+    }
+
+    double minX = placed[0].m_x, maxX = placed[0].m_x;
+    double minY = placed[0].m_y, maxY = placed[0].m_y;
+    for (size_t i = 0; i < placed.size(); i++)
+    {
+        auto a = placed[i];
+        auto b = placed[(i + 1) % placed.size()];
+
+        minX = std::min(minX, a.m_x);
+        maxX = std::max(maxX, a.m_x);
+        minY = std::min(minY, a.m_y);
+        maxY = std::max(maxY, a.m_y);
+
+        // Horizontal edges can never be crossed
+        if (a.m_y == b.m_y)
+        {
+            continue;
+        }
+
+        mEdgeX0.push_back(a.m_x);
+        mEdgeY0.push_back(a.m_y);
+        mEdgeY1.push_back(b.m_y);
+        mEdgeSlope.push_back((b.m_x - a.m_x) / (b.m_y - a.m_y));
+    }
+
+    // Whole pixels that cover the placed polygon
+    mEdgeBounds = wxRect(wxPoint(int(floor(minX)), int(floor(minY))),
+            wxPoint(int(ceil(maxX)), int(ceil(maxY))));
 }
 
 
@@ -68,4 +232,6 @@ bool PolyDrawable::HitTest(wxPoint pos)
 void PolyDrawable::AddPoint(wxPoint point)
 {
     mPoints.push_back(point);
+    mEdgesValid = false;
+    mPathValid = false;
 }
@@ -20,15 +20,50 @@ class PolyDrawable : public Drawable {
 private:
 
     /// The polygon color
-    wxColour mColor = *wxBLACK;
+    wxColour mColor = wxColour(0, 0, 0);
 
     /// The array of point objects
     std::vector<wxPoint> mPoints;
 
-    /// The transformed graphics path used
-    /// to draw this polygon
+    /// The graphics path used to draw this polygon, in
+    /// local coordinates. Built once and reused every frame.
     wxGraphicsPath mPath;
 
+    /// True if mPath has been built from the current points
+    bool mPathValid = false;
+
+    /// Brush used to fill the polygon
+    wxBrush mBrush = wxBrush(wxColour(0, 0, 0));
+
+    /// Edge table for the placed polygon, kept as parallel arrays
+    /// so the hit test crossing loop can vectorize.
+    /// X coordinate of the first endpoint of each edge
+    std::vector<double> mEdgeX0;
+
+    /// Y coordinate of the first endpoint of each edge
+    std::vector<double> mEdgeY0;
+
+    /// Y coordinate of the second endpoint of each edge
+    std::vector<double> mEdgeY1;
+
+    /// Inverse slope (dx/dy) of each edge
+    std::vector<double> mEdgeSlope;
+
+    /// Bounding box of the placed polygon
+    wxRect mEdgeBounds;
+
+    /// Placed position the edge table was built for
+    wxPoint mEdgePosition;
+
+    /// Placed rotation the edge table was built for
+    double mEdgeR = 0;
+
+    /// True if the edge table matches the current points and placement
+    bool mEdgesValid = false;
+
+    void UpdateEdges();
+    void UpdatePath(std::shared_ptr<wxGraphicsContext> graphics);
+
 public:
     PolyDrawable(const std::wstring& name);
 
@@ -42,7 +77,10 @@ public:
     void operator=(const PolyDrawable &) = delete;
 
     void Draw(std::shared_ptr<wxGraphicsContext> graphics) override;
+    void Record(RenderCommandList &commands) override;
+    void Rasterize(SoftwareRasterizer &rasterizer) override;
     bool HitTest(wxPoint pos) override;
+    wxRect GetBoundingBox() override;
 
     void AddPoint(wxPoint point);
 
@@ -50,7 +88,7 @@ public:
      * Set the color for the polygon
      * @param color New color to set
      */
-    void SetColor(wxColour color) { mColor = color; }
+    void SetColor(wxColour color) { mColor = color; mBrush.SetColour(color); }
 
     /**
      * Get the drawable color
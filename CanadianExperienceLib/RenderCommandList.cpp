@@ -0,0 +1,372 @@
+/**
+ * @file RenderCommandList.cpp
+ * @author Shane Carr
+ */
+
+#include "pch.h"
+#include "RenderCommandList.h"
+#include "Drawable.h"
+
+
+/**
+ * Start recording a new frame.
+ *
+ * Clears the commands and the style tables from the last
+ * frame. The storage is kept so recording does not allocate.
+ * @param graphics Graphics context we will execute on
+ */
+void RenderCommandList::Begin(std::shared_ptr<wxGraphicsContext> graphics)
+{
+    mGraphics = graphics;
+    mCommands.clear();
+    mBrushes.clear();
+    mPens.clear();
+}
+
+
+/**
+ * Find or add a brush in the brush table
+ * @param brush Brush to find
+ * @return Index into mBrushes
+ */
+int RenderCommandList::BrushIndex(const wxBrush &brush)
+{
+    for (size_t i = 0; i < mBrushes.size(); i++)
+    {
+        if (mBrushes[i] == brush)
+        {
+            return int(i);
+        }
+    }
+
+    mBrushes.push_back(brush);
+    return int(mBrushes.size() - 1);
+}
+
+
+/**
+ * Find or add a pen in the pen table
+ * @param pen Pen to find
+ * @return Index into mPens
+ */
+int RenderCommandList::PenIndex(const wxPen &pen)
+{
+    for (size_t i = 0; i < mPens.size(); i++)
+    {
+        if (mPens[i] == pen)
+        {
+            return int(i);
+        }
+    }
+
+    mPens.push_back(pen);
+    return int(mPens.size() - 1);
+}
+
+
+/**
+ * Record drawing a bitmap
+ * @param bitmap Graphics bitmap to draw
+ * @param image Image the bitmap was created from
+ * @param position Where to translate to
+ * @param angle Rotation after translation
+ * @param left Left of the bitmap in local space
+ * @param top Top of the bitmap in local space
+ * @param width Drawn width
+ * @param height Drawn height
+ * @param source Sub-rectangle of an atlas page bitmap to draw, empty for the whole bitmap
+ * @param sheet Width and height of the atlas page
+ */
+void RenderCommandList::AddBitmap(const wxGraphicsBitmap &bitmap, const wxImage *image,
+        wxPoint position, double angle, double left, double top, double width, double height,
+        const wxRect &source, int sheet)
+{
+    Command command;
+    command.kind = Kind::Bitmap;
+    command.x = position.x;
+    command.y = position.y;
+    command.angle = angle;
+    command.a = left;
+    command.b = top;
+    command.c = width;
+    command.d = height;
+    command.bitmap = &bitmap;
+    command.image = image;
+    command.source = source;
+    command.sheet = sheet;
+    mCommands.push_back(command);
+}
+
+
+/**
+ * Record filling a path
+ * @param path Path in local space
+ * @param points The points the path was built from
+ * @param brush Brush to fill with
+ * @param position Where to translate to
+ * @param angle Rotation after translation
+ * @param bounds Bounds of the fill in picture space
+ */
+void RenderCommandList::AddFill(const wxGraphicsPath &path, const std::vector<wxPoint> *points,
+        const wxBrush &brush, wxPoint position, double angle, const wxRect &bounds)
+{
+    Command command;
+    command.kind = Kind::Fill;
+    command.x = position.x;
+    command.y = position.y;
+    command.angle = angle;
+    command.brush = BrushIndex(brush);
+    command.bounds = bounds;
+    command.path = &path;
+    command.points = points;
+    mCommands.push_back(command);
+}
+
+
+/**
+ * Record drawing an ellipse
+ * @param brush Brush to fill with
+ * @param pen Pen to outline with
+ * @param position Where to translate to
+ * @param angle Rotation after translation
+ * @param left Left of the ellipse in local space
+ * @param top Top of the ellipse in local space
+ * @param width Ellipse width
+ * @param height Ellipse height
+ */
+void RenderCommandList::AddEllipse(const wxBrush &brush, const wxPen &pen,
+        wxPoint position, double angle, double left, double top, double width, double height)
+{
+    Command command;
+    command.kind = Kind::Ellipse;
+    command.x = position.x;
+    command.y = position.y;
+    command.angle = angle;
+    command.a = left;
+    command.b = top;
+    command.c = width;
+    command.d = height;
+    command.brush = BrushIndex(brush);
+    command.pen = PenIndex(pen);
+    mCommands.push_back(command);
+}
+
+
+/**
+ * Record stroking a line in picture space
+ * @param pen Pen to stroke with
+ * @param p1 First point
+ * @param p2 Second point
+ */
+void RenderCommandList::AddLine(const wxPen &pen, wxPoint p1, wxPoint p2)
+{
+    Command command;
+    command.kind = Kind::Line;
+    command.a = p1.x;
+    command.b = p1.y;
+    command.c = p2.x;
+    command.d = p2.y;
+    command.pen = PenIndex(pen);
+    mCommands.push_back(command);
+}
+
+
+/**
+ * Record a drawable that draws itself directly.
+ *
+ * This is the fallback for drawables that do not record
+ * commands of their own.
+ * @param drawable Drawable to draw
+ */
+void RenderCommandList::AddDrawable(Drawable *drawable)
+{
+    Command command;
+    command.kind = Kind::Drawable;
+    command.drawable = drawable;
+    mCommands.push_back(command);
+}
+
+
+/**
+ * Find the end of a run of fills that can be merged.
+ *
+ * Fills can merge if they are adjacent, use the same brush,
+ * were recorded with their points and none of them overlap.
+ * Overlapping fills can't merge because the even-odd rule
+ * would punch holes where they cross.
+ * @param start Index of the first fill in the run
+ * @return Index one past the last fill in the run
+ */
+size_t RenderCommandList::FillRunEnd(size_t start)
+{
+    auto brush = mCommands[start].brush;
+    if (mCommands[start].points == nullptr)
+    {
+        return start + 1;
+    }
+
+    auto end = start + 1;
+    for ( ; end < mCommands.size(); end++)
+    {
+        const auto &command = mCommands[end];
+        if (command.kind != Kind::Fill || command.brush != brush || command.points == nullptr)
+        {
+            break;
+        }
+
+        for (auto i = start; i < end; i++)
+        {
+            if (mCommands[i].bounds.Intersects(command.bounds))
+            {
+                return end;
+            }
+        }
+    }
+
+    return end;
+}
+
+
+/**
+ * Add the polygon of a fill command to a path in picture space.
+ *
+ * The points are placed here rather than by transforming a
+ * copy of the command's path, so merging does not create a
+ * path and matrix for every fill.
+ * @param path Path to add to
+ * @param fill Fill command with points
+ */
+void RenderCommandList::AddPlacedPolygon(wxGraphicsPath &path, const Command &fill)
+{
+    const auto &points = *fill.points;
+    if (points.empty())
+    {
+        return;
+    }
+
+    auto cs = cos(-fill.angle);
+    auto sn = sin(-fill.angle);
+    auto place = [&fill, cs, sn](wxPoint point) {
+        return wxPoint2DDouble(fill.x + cs * point.x - sn * point.y,
+                fill.y + sn * point.x + cs * point.y);
+    };
+
+    path.MoveToPoint(place(points[0]));
+    for (size_t i = 1; i < points.size(); i++)
+    {
+        path.AddLineToPoint(place(points[i]));
+    }
+    path.CloseSubpath();
+}
+
+
+/**
+ * Replay the recorded commands on the graphics context.
+ */
+void RenderCommandList::Execute()
+{
+    auto graphics = mGraphics;
+    mStateChanges = 0;
+    mDrawCalls = 0;
+    if (graphics == nullptr)
+    {
+        return;
+    }
+
+    // Current brush and pen, -1 if unknown
+    int brush = -1;
+    int pen = -1;
+
+    size_t i = 0;
+    while (i < mCommands.size())
+    {
+        const auto &command = mCommands[i];
+
+        if (command.brush >= 0 && command.brush != brush)
+        {
+            graphics->SetBrush(mBrushes[command.brush]);
+            brush = command.brush;
+            mStateChanges++;
+        }
+
+        if (command.pen >= 0 && command.pen != pen)
+        {
+            graphics->SetPen(mPens[command.pen]);
+            pen = command.pen;
+            mStateChanges++;
+        }
+
+        mDrawCalls++;
+
+        switch (command.kind)
+        {
+        case Kind::Bitmap:
+            graphics->PushState();
+            graphics->Translate(command.x, command.y);
+            graphics->Rotate(-command.angle);
+            if (command.source.IsEmpty())
+            {
+                graphics->DrawBitmap(*command.bitmap, command.a, command.b, command.c, command.d);
+            }
+            else
+            {
+                // Draw the whole atlas page clipped to our part of it
+                graphics->Clip(command.a, command.b, command.c, command.d);
+                graphics->DrawBitmap(*command.bitmap, command.a - command.source.x,
+                        command.b - command.source.y, command.sheet, command.sheet);
+            }
+            graphics->PopState();
+            break;
+
+        case Kind::Fill:
+        {
+            auto end = FillRunEnd(i);
+            if (end == i + 1)
+            {
+                graphics->PushState();
+                graphics->Translate(command.x, command.y);
+                graphics->Rotate(-command.angle);
+                graphics->FillPath(*command.path);
+                graphics->PopState();
+            }
+            else
+            {
+                // Place each polygon's points directly into one path,
+                // so the whole run costs a single path and fill
+                auto merged = graphics->CreatePath();
+                for (auto j = i; j < end; j++)
+                {
+                    AddPlacedPolygon(merged, mCommands[j]);
+                }
+
+                graphics->FillPath(merged);
+            }
+
+            i = end;
+            continue;
+        }
+
+        case Kind::Ellipse:
+            graphics->PushState();
+            graphics->Translate(command.x, command.y);
+            graphics->Rotate(-command.angle);
+            graphics->DrawEllipse(command.a, command.b, command.c, command.d);
+            graphics->PopState();
+            break;
+
+        case Kind::Line:
+            graphics->StrokeLine(command.a, command.b, command.c, command.d);
+            break;
+
+        case Kind::Drawable:
+            command.drawable->Draw(graphics);
+
+            // We don't know what the drawable left set
+            brush = -1;
+            pen = -1;
+            break;
+        }
+
+        i++;
+    }
+}
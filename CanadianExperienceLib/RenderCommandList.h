@@ -0,0 +1,171 @@
+/**
+ * @file RenderCommandList.h
+ * @author Shane Carr
+ *
+ * A per-frame list of recorded drawing commands.
+ */
+
+#ifndef CANADIANEXPERIENCE_RENDERCOMMANDLIST_H
+#define CANADIANEXPERIENCE_RENDERCOMMANDLIST_H
+
+class Drawable;
+
+/**
+ * A per-frame list of recorded drawing commands.
+ *
+ * Drawables record compact commands into this list rather
+ * than drawing directly. Execute replays them in paint order,
+ * skipping brush and pen changes that would not change
+ * anything and merging adjacent fills that use the same brush
+ * and do not overlap into a single fill.
+ *
+ * The list keeps its storage between frames, so after the first
+ * frame recording does not allocate. Executing creates one path
+ * for each merged run of fills and nothing for the others.
+ */
+class RenderCommandList {
+public:
+    /// The kinds of commands we can record
+    enum class Kind {Bitmap, Fill, Ellipse, Line, Drawable};
+
+    /**
+     * A single recorded command.
+     *
+     * Every command draws in a local space that is placed by
+     * a translation to (x, y) followed by a rotation of angle.
+     */
+    struct Command
+    {
+        /// What kind of command this is
+        Kind kind = Kind::Drawable;
+
+        /// X translation for the command
+        double x = 0;
+
+        /// Y translation for the command
+        double y = 0;
+
+        /// Rotation angle in radians
+        double angle = 0;
+
+        /// Local geometry: left/top/width/height for bitmaps and
+        /// ellipses, or x1/y1/x2/y2 for lines
+        double a = 0, b = 0, c = 0, d = 0;
+
+        /// Index into the brush table or -1 for none
+        int brush = -1;
+
+        /// Index into the pen table or -1 for none
+        int pen = -1;
+
+        /// Picture space bounds, used to decide if fills can merge
+        wxRect bounds;
+
+        /// Source rectangle on an atlas page, empty if the
+        /// bitmap is drawn whole
+        wxRect source;
+
+        /// Size of the atlas page the source is on
+        int sheet = 0;
+
+        /// Bitmap to draw for Bitmap commands
+        const wxGraphicsBitmap *bitmap = nullptr;
+
+        /// Source image for Bitmap commands
+        const wxImage *image = nullptr;
+
+        /// Local space path for Fill commands
+        const wxGraphicsPath *path = nullptr;
+
+        /// Local space points for Fill commands
+        const std::vector<wxPoint> *points = nullptr;
+
+        /// Drawable to draw directly for Drawable commands
+        Drawable *drawable = nullptr;
+    };
+
+private:
+    /// The graphics context we are recording for
+    std::shared_ptr<wxGraphicsContext> mGraphics;
+
+    /// The recorded commands in paint order
+    std::vector<Command> mCommands;
+
+    /// The distinct brushes used this frame
+    std::vector<wxBrush> mBrushes;
+
+    /// The distinct pens used this frame
+    std::vector<wxPen> mPens;
+
+    /// Number of brush and pen changes made by the last Execute
+    int mStateChanges = 0;
+
+    /// Number of draw calls made by the last Execute
+    int mDrawCalls = 0;
+
+    int BrushIndex(const wxBrush &brush);
+    int PenIndex(const wxPen &pen);
+    size_t FillRunEnd(size_t start);
+    static void AddPlacedPolygon(wxGraphicsPath &path, const Command &fill);
+
+public:
+    RenderCommandList() {}
+
+    /// Copy constructor (disabled)
+    RenderCommandList(const RenderCommandList &) = delete;
+
+    /// Assignment operator (disabled)
+    void operator=(const RenderCommandList &) = delete;
+
+    void Begin(std::shared_ptr<wxGraphicsContext> graphics);
+    void Execute();
+
+    void AddBitmap(const wxGraphicsBitmap &bitmap, const wxImage *image,
+            wxPoint position, double angle, double left, double top, double width, double height,
+            const wxRect &source = wxRect(), int sheet = 0);
+    void AddFill(const wxGraphicsPath &path, const std::vector<wxPoint> *points,
+            const wxBrush &brush, wxPoint position, double angle, const wxRect &bounds);
+    void AddEllipse(const wxBrush &brush, const wxPen &pen,
+            wxPoint position, double angle, double left, double top, double width, double height);
+    void AddLine(const wxPen &pen, wxPoint p1, wxPoint p2);
+    void AddDrawable(Drawable *drawable);
+
+    /**
+     * The graphics context we are recording for. Drawables use
+     * this to create their bitmaps and paths.
+     * @return Graphics context
+     */
+    std::shared_ptr<wxGraphicsContext> GetGraphics() const { return mGraphics; }
+
+    /**
+     * Get the recorded commands
+     * @return Vector of commands in paint order
+     */
+    const std::vector<Command> &GetCommands() const { return mCommands; }
+
+    /**
+     * Number of distinct brushes recorded this frame
+     * @return Brush count
+     */
+    size_t GetBrushCount() const { return mBrushes.size(); }
+
+    /**
+     * Number of distinct pens recorded this frame
+     * @return Pen count
+     */
+    size_t GetPenCount() const { return mPens.size(); }
+
+    /**
+     * Number of brush and pen changes made by the last Execute
+     * @return State change count
+     */
+    int GetStateChanges() const { return mStateChanges; }
+
+    /**
+     * Number of draw calls made by the last Execute
+     * @return Draw call count
+     */
+    int GetDrawCalls() const { return mDrawCalls; }
+};
+
+#endif //CANADIANEXPERIENCE_RENDERCOMMANDLIST_H
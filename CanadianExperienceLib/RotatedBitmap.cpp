@@ -5,6 +5,11 @@
 
 #include "pch.h"
 #include "RotatedBitmap.h"
+#include "RenderCommandList.h"
+#include "ImageAtlas.h"
+
+#include <image-cache.h>
+#include <software-rasterizer.h>
 
 
 
@@ -14,7 +19,7 @@
  */
 void RotatedBitmap::LoadImage(const std::wstring &filename)
 {
-    mImage = std::make_unique<wxImage>(filename, wxBITMAP_TYPE_ANY);
+    mImage = ImageCache::Get().Load(filename);
     mLoaded = true;
 }
 
@@ -27,9 +32,18 @@ void RotatedBitmap::LoadImage(const std::wstring &filename)
  */
 void RotatedBitmap::DrawImage(std::shared_ptr<wxGraphicsContext> graphics, wxPoint position, double angle)
 {
+    if (mSprites != nullptr)
+    {
+        mSprite = mSprites->Get(graphics, mImage, mCenter, angle);
+        graphics->DrawBitmap(mSprite->bitmap, position.x + mSprite->left, position.y + mSprite->top,
+                mSprite->width, mSprite->height);
+        return;
+    }
+
     if(!mBitmapCreated)
     {
-        mBitmap = graphics->CreateBitmapFromImage(*mImage);
+        mBitmap = ImageCache::Get().GetBitmap(graphics, mImage);
+        mBitmapCreated = true;
     }
 
     graphics->PushState();
@@ -39,4 +53,89 @@ void RotatedBitmap::DrawImage(std::shared_ptr<wxGraphicsContext> graphics, wxPoi
             mImage->GetWidth(), mImage->GetHeight());
 
     graphics->PopState();
-}
\ No newline at end of file
+}
+
+
+/**
+ * Record the command to draw the bitmap
+ * @param commands Command list to record into
+ * @param position The position to draw at
+ * @param angle The rotation angle
+ */
+void RotatedBitmap::Record(RenderCommandList &commands, wxPoint position, double angle)
+{
+    if (mSprites != nullptr)
+    {
+        mSprite = mSprites->Get(commands.GetGraphics(), mImage, mCenter, angle);
+        commands.AddBitmap(mSprite->bitmap, nullptr, position, 0,
+                mSprite->left, mSprite->top, mSprite->width, mSprite->height);
+        return;
+    }
+
+    if (mAtlas != nullptr)
+    {
+        mAtlas->Build(commands.GetGraphics());
+        commands.AddBitmap(mAtlas->GetBitmap(mAtlasEntry), mImage.get(), position, angle,
+                -mCenter.x, -mCenter.y, mImage->GetWidth(), mImage->GetHeight(),
+                mAtlas->GetRect(mAtlasEntry), mAtlas->GetPageSize());
+        return;
+    }
+
+    if(!mBitmapCreated)
+    {
+        mBitmap = ImageCache::Get().GetBitmap(commands.GetGraphics(), mImage);
+        mBitmapCreated = true;
+    }
+
+    commands.AddBitmap(mBitmap, mImage.get(), position, angle,
+            -mCenter.x, -mCenter.y, mImage->GetWidth(), mImage->GetHeight());
+}
+
+
+/**
+ * Draw the image with the software rasterizer
+ * @param rasterizer Rasterizer to draw into
+ * @param position Position to draw the center at
+ * @param angle Rotation angle in radians
+ */
+void RotatedBitmap::Rasterize(SoftwareRasterizer &rasterizer, wxPoint position, double angle)
+{
+    rasterizer.PushState();
+    rasterizer.Translate(position.x, position.y);
+    rasterizer.Rotate(-angle);
+    rasterizer.DrawImage(mImage, -mCenter.x, -mCenter.y, mImage->GetWidth(), mImage->GetHeight());
+    rasterizer.PopState();
+}
+
+
+/**
+ * Pack this image into an atlas
+ * @param atlas Atlas to add the image to
+ */
+void RotatedBitmap::SetAtlas(std::shared_ptr<ImageAtlas> atlas)
+{
+    if (!mLoaded)
+    {
+        return;
+    }
+
+    mAtlasEntry = atlas->Add(*mImage);
+    mAtlas = mAtlasEntry >= 0 ? atlas : nullptr;
+}
+
+
+/**
+ * Draw this image through a cache of pre-rotated sprites.
+ *
+ * Does nothing if the image is too large for the cache.
+ * @param sprites Sprite cache to use
+ */
+void RotatedBitmap::SetSpriteCache(std::shared_ptr<RotatedSpriteCache> sprites)
+{
+    if (!mLoaded || !sprites->Accepts(*mImage))
+    {
+        return;
+    }
+
+    mSprites = sprites;
+}
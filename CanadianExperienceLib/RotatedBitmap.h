@@ -8,13 +8,19 @@
 #ifndef CANADIANEXPERIENCE_ROTATEDBITMAP_H
 #define CANADIANEXPERIENCE_ROTATEDBITMAP_H
 
+class RenderCommandList;
+class ImageAtlas;
+class SoftwareRasterizer;
+
+#include "RotatedSpriteCache.h"
+
 /**
  * Basic class for displaying a rotated bitmap
  */
 class RotatedBitmap {
 private:
     /// The image for this drawable
-    std::unique_ptr<wxImage> mImage;
+    std::shared_ptr<const wxImage> mImage;
 
     /// The graphics bitmap we will use
     wxGraphicsBitmap mBitmap;
@@ -28,6 +34,18 @@ private:
     /// Has an image been loaded?
     bool mLoaded = false;
 
+    /// Atlas the image is packed into, if any
+    std::shared_ptr<ImageAtlas> mAtlas;
+
+    /// Our entry in the atlas
+    int mAtlasEntry = -1;
+
+    /// Cache of pre-rotated copies of the image, if any
+    std::shared_ptr<RotatedSpriteCache> mSprites;
+
+    /// The sprite we last drew, kept alive until the next draw
+    std::shared_ptr<const RotatedSpriteCache::Sprite> mSprite;
+
 public:
     /// Constructor
     RotatedBitmap() {}
@@ -42,6 +60,13 @@ public:
 
     void DrawImage(std::shared_ptr<wxGraphicsContext> graphics, wxPoint position, double angle);
 
+    void Record(RenderCommandList &commands, wxPoint position, double angle);
+
+    void Rasterize(SoftwareRasterizer &rasterizer, wxPoint position, double angle);
+
+    void SetAtlas(std::shared_ptr<ImageAtlas> atlas);
+    void SetSpriteCache(std::shared_ptr<RotatedSpriteCache> sprites);
+
     /**
      * Set the center to rotate around
      * @param center New center
@@ -0,0 +1,227 @@
+/**
+ * @file RotatedSpriteCache.cpp
+ * @author Shane Carr
+ */
+
+#include "pch.h"
+#include <cmath>
+
+#include "RotatedSpriteCache.h"
+
+/**
+ * Constructor
+ * @param steps Number of angles in a full turn
+ * @param capacity Most bytes of sprites to keep
+ * @param maxSize Largest image width or height to cache
+ */
+RotatedSpriteCache::RotatedSpriteCache(int steps, size_t capacity, int maxSize) :
+    mSteps(steps), mCapacity(capacity), mMaxSize(maxSize)
+{
+}
+
+
+/**
+ * Is this image small enough to cache?
+ * @param image Image to test
+ * @return true if the cache will handle it
+ */
+bool RotatedSpriteCache::Accepts(const wxImage &image) const
+{
+    return image.IsOk() && image.GetWidth() <= mMaxSize && image.GetHeight() <= mMaxSize;
+}
+
+
+/**
+ * Convert an angle to the nearest quantized step
+ * @param angle Angle in radians
+ * @return Step in the range 0 to steps - 1
+ */
+int RotatedSpriteCache::Quantize(double angle) const
+{
+    auto step = lround(angle / (M_PI * 2) * mSteps) % mSteps;
+    return int(step < 0 ? step + mSteps : step);
+}
+
+
+/**
+ * Get an image rotated to the nearest quantized angle.
+ *
+ * The angle follows the drawable convention: drawing the
+ * sprite at a position matches translating there, rotating
+ * by -angle and drawing the image with its center there.
+ * @param graphics Graphics context the sprite will be drawn with
+ * @param image Image to rotate, must be accepted by Accepts
+ * @param center Rotation center in image pixels
+ * @param angle Rotation angle in radians
+ * @return The sprite
+ */
+std::shared_ptr<const RotatedSpriteCache::Sprite> RotatedSpriteCache::Get(std::shared_ptr<wxGraphicsContext> graphics,
+        const std::shared_ptr<const wxImage> &image, wxPoint center, double angle)
+{
+    int step = Quantize(angle);
+    Key key(image.get(), center.x, center.y, step);
+
+    auto found = mSprites.find(key);
+    if (found != mSprites.end())
+    {
+        if (found->second.image.lock() == image)
+        {
+            mHits++;
+            mUsed.splice(mUsed.begin(), mUsed, found->second.used);
+            return found->second.sprite;
+        }
+
+        // A different image now lives at this address
+        Evict(found);
+    }
+
+    mMisses++;
+
+    wxPoint topLeft;
+    auto rotated = Rotate(*image, center, step * M_PI * 2 / mSteps, topLeft);
+
+    auto sprite = std::make_shared<Sprite>();
+    sprite->bitmap = graphics->CreateBitmapFromImage(rotated);
+    sprite->left = topLeft.x;
+    sprite->top = topLeft.y;
+    sprite->width = rotated.GetWidth();
+    sprite->height = rotated.GetHeight();
+
+    Entry entry;
+    entry.image = image;
+    entry.sprite = sprite;
+    entry.bytes = size_t(sprite->width) * sprite->height * 4;
+
+    // Make room, oldest first
+    while (!mUsed.empty() && mBytes + entry.bytes > mCapacity)
+    {
+        Evict(mSprites.find(mUsed.back()));
+        mEvictions++;
+    }
+
+    mUsed.push_front(key);
+    entry.used = mUsed.begin();
+    mBytes += entry.bytes;
+    mSprites[key] = entry;
+
+    return sprite;
+}
+
+
+/**
+ * Remove a sprite from the cache.
+ *
+ * Anyone still drawing the sprite keeps it alive.
+ * @param entry Sprite to remove
+ */
+void RotatedSpriteCache::Evict(std::map<Key, Entry>::iterator entry)
+{
+    mBytes -= entry->second.bytes;
+    mUsed.erase(entry->second.used);
+    mSprites.erase(entry);
+}
+
+
+/**
+ * Rotate an image with bilinear filtering.
+ *
+ * Filtering is done on premultiplied colors so transparent
+ * pixels don't bleed their color into the edges.
+ * @param image Image to rotate
+ * @param center Rotation center in image pixels
+ * @param angle Rotation angle in radians
+ * @param topLeft Set to the top left of the result relative to the center
+ * @return The rotated image, with alpha
+ */
+wxImage RotatedSpriteCache::Rotate(const wxImage &image, wxPoint center, double angle, wxPoint &topLeft)
+{
+    // The image is shared through the image cache, so read it
+    // through the reference. Copy-constructing it would touch its
+    // reference count, which is not safe across threads.
+    const wxImage *source = &image;
+    wxImage withAlpha;
+    if (!image.HasAlpha())
+    {
+        withAlpha = image.Copy();
+        withAlpha.InitAlpha();
+        source = &withAlpha;
+    }
+
+    int srcWid = source->GetWidth();
+    int srcHit = source->GetHeight();
+    const unsigned char *srcRgb = source->GetData();
+    const unsigned char *srcAlpha = source->GetAlpha();
+
+    double c = cos(angle);
+    double s = sin(angle);
+
+    // Bounds of the rotated corners
+    double minX = 1e9, minY = 1e9, maxX = -1e9, maxY = -1e9;
+    for (auto corner : {wxPoint(0, 0), wxPoint(srcWid, 0), wxPoint(srcWid, srcHit), wxPoint(0, srcHit)})
+    {
+        double x = corner.x - center.x;
+        double y = corner.y - center.y;
+        double px = x * c + y * s;
+        double py = -x * s + y * c;
+        minX = std::min(minX, px);
+        minY = std::min(minY, py);
+        maxX = std::max(maxX, px);
+        maxY = std::max(maxY, py);
+    }
+
+    // Round outwards, ignoring rounding error in sin and cos
+    const double Tolerance = 1e-6;
+    topLeft = wxPoint(int(floor(minX + Tolerance)), int(floor(minY + Tolerance)));
+    int wid = std::max(1, int(ceil(maxX - Tolerance)) - topLeft.x);
+    int hit = std::max(1, int(ceil(maxY - Tolerance)) - topLeft.y);
+
+    wxImage rotated(wid, hit, false);
+    rotated.InitAlpha();
+    unsigned char *rgb = rotated.GetData();
+    unsigned char *alpha = rotated.GetAlpha();
+
+    for (int j = 0; j < hit; j++)
+    {
+        for (int i = 0; i < wid; i++)
+        {
+            // Pixel center back into the source, in pixel index space
+            double px = topLeft.x + i + 0.5;
+            double py = topLeft.y + j + 0.5;
+            double sx = px * c - py * s + center.x - 0.5;
+            double sy = px * s + py * c + center.y - 0.5;
+
+            int x0 = int(floor(sx));
+            int y0 = int(floor(sy));
+            double fx = sx - x0;
+            double fy = sy - y0;
+
+            double sum[4] = {0, 0, 0, 0};
+            for (int k = 0; k < 4; k++)
+            {
+                int x = x0 + (k & 1);
+                int y = y0 + (k >> 1);
+                if (x < 0 || y < 0 || x >= srcWid || y >= srcHit)
+                {
+                    continue;
+                }
+
+                double weight = ((k & 1) ? fx : 1 - fx) * ((k >> 1) ? fy : 1 - fy);
+                size_t at = size_t(y) * srcWid + x;
+                double a = srcAlpha[at] * weight;
+                sum[0] += a;
+                sum[1] += srcRgb[at * 3] * a;
+                sum[2] += srcRgb[at * 3 + 1] * a;
+                sum[3] += srcRgb[at * 3 + 2] * a;
+            }
+
+            size_t at = size_t(j) * wid + i;
+            alpha[at] = (unsigned char)lround(sum[0]);
+            for (int k = 0; k < 3; k++)
+            {
+                rgb[at * 3 + k] = sum[0] > 0 ? (unsigned char)lround(sum[k + 1] / sum[0]) : 0;
+            }
+        }
+    }
+
+    return rotated;
+}
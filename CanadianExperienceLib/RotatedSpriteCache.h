@@ -0,0 +1,147 @@
+/**
+ * @file RotatedSpriteCache.h
+ * @author Shane Carr
+ *
+ * Cache of small images pre-rotated to quantized angles.
+ */
+
+#ifndef CANADIANEXPERIENCE_ROTATEDSPRITECACHE_H
+#define CANADIANEXPERIENCE_ROTATEDSPRITECACHE_H
+
+#include <list>
+#include <map>
+#include <tuple>
+
+/**
+ * Cache of small images pre-rotated to quantized angles.
+ *
+ * Drawing a rotated bitmap costs a transformed blit every
+ * frame, which is slow on software renderers. For small
+ * images we instead rotate the pixels ourselves, with
+ * bilinear filtering, to the nearest quantized angle and
+ * keep the result. Drawing is then a plain translated blit.
+ *
+ * Rotations are made the first time an angle is used. The
+ * least recently used ones are evicted to keep the cache
+ * under its byte limit.
+ */
+class RotatedSpriteCache {
+public:
+    /// An image rotated to one angle
+    struct Sprite
+    {
+        /// The rotated image as a graphics bitmap
+        wxGraphicsBitmap bitmap;
+
+        /// Left of the bitmap relative to the rotation center
+        int left = 0;
+
+        /// Top of the bitmap relative to the rotation center
+        int top = 0;
+
+        /// Bitmap width
+        int width = 0;
+
+        /// Bitmap height
+        int height = 0;
+    };
+
+private:
+    /// Identifies a sprite: image, rotation center and angle step
+    using Key = std::tuple<const wxImage *, int, int, int>;
+
+    /// A cached sprite
+    struct Entry
+    {
+        /// The image that was rotated, to detect reused addresses
+        std::weak_ptr<const wxImage> image;
+
+        /// The rotated sprite
+        std::shared_ptr<Sprite> sprite;
+
+        /// Bytes the sprite occupies
+        size_t bytes = 0;
+
+        /// Position in the recently used list
+        std::list<Key>::iterator used;
+    };
+
+    /// Number of angles in a full turn
+    int mSteps;
+
+    /// Most bytes of sprites to keep
+    size_t mCapacity;
+
+    /// Largest image width or height we will cache
+    int mMaxSize;
+
+    /// Cached sprites
+    std::map<Key, Entry> mSprites;
+
+    /// Keys, most recently used first
+    std::list<Key> mUsed;
+
+    /// Bytes of sprites currently cached
+    size_t mBytes = 0;
+
+    /// Number of lookups that found a sprite
+    int mHits = 0;
+
+    /// Number of lookups that had to rotate
+    int mMisses = 0;
+
+    /// Number of sprites evicted
+    int mEvictions = 0;
+
+    void Evict(std::map<Key, Entry>::iterator entry);
+
+public:
+    RotatedSpriteCache(int steps = 360, size_t capacity = 16 * 1024 * 1024, int maxSize = 128);
+
+    /// Copy constructor (disabled)
+    RotatedSpriteCache(const RotatedSpriteCache &) = delete;
+
+    /// Assignment operator (disabled)
+    void operator=(const RotatedSpriteCache &) = delete;
+
+    bool Accepts(const wxImage &image) const;
+
+    std::shared_ptr<const Sprite> Get(std::shared_ptr<wxGraphicsContext> graphics,
+            const std::shared_ptr<const wxImage> &image, wxPoint center, double angle);
+
+    int Quantize(double angle) const;
+
+    static wxImage Rotate(const wxImage &image, wxPoint center, double angle, wxPoint &topLeft);
+
+    /**
+     * Bytes of sprites currently cached
+     * @return Byte count
+     */
+    size_t GetBytes() const { return mBytes; }
+
+    /**
+     * Number of sprites currently cached
+     * @return Sprite count
+     */
+    size_t GetCount() const { return mSprites.size(); }
+
+    /**
+     * Number of lookups that found a sprite
+     * @return Hit count
+     */
+    int GetHits() const { return mHits; }
+
+    /**
+     * Number of lookups that had to rotate
+     * @return Miss count
+     */
+    int GetMisses() const { return mMisses; }
+
+    /**
+     * Number of sprites evicted to stay under the limit
+     * @return Eviction count
+     */
+    int GetEvictions() const { return mEvictions; }
+};
+
+#endif //CANADIANEXPERIENCE_ROTATEDSPRITECACHE_H
@@ -9,14 +9,16 @@
 #include "PolyDrawable.h"
 #include "ImageDrawable.h"
 #include "HeadTop.h"
+#include "ImageAtlas.h"
 
 
 /**
  * This is a factory method that creates our Harold actor.
  * @param imagesDir Directory that contains the images for this application
+ * @param atlas Optional atlas to pack the images into
  * @return Pointer to an actor object.
  */
-std::shared_ptr<Actor> SpartyFactory::Create(std::wstring imagesDir)
+std::shared_ptr<Actor> SpartyFactory::Create(std::wstring imagesDir, std::shared_ptr<ImageAtlas> atlas)
 {
     std::shared_ptr<Actor> actor = std::make_shared<Actor>(L"Sparty");
 
@@ -72,6 +74,14 @@ std::shared_ptr<Actor> SpartyFactory::Create(std::wstring imagesDir)
     actor->AddDrawable(headb);
     actor->AddDrawable(headt);
 
+    if (atlas != nullptr)
+    {
+        std::vector<std::shared_ptr<ImageDrawable>> images = {torso, lleg, rleg, larm, rarm, headb, headt};
+        for (auto image : images)
+        {
+            image->SetAtlas(atlas);
+        }
+    }
 
     return actor;
 }
\ No newline at end of file
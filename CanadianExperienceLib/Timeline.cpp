@@ -56,6 +56,22 @@ void Timeline::ClearKeyframe()
 }
 
 
+/**
+ * Set the frame a machine starts running at
+ * @param machine Machine index, 0 for the first machine
+ * @param frame Starting frame number
+ */
+void Timeline::SetMachineStartFrame(size_t machine, int frame)
+{
+    if (machine >= mMachineStartFrames.size())
+    {
+        mMachineStartFrames.resize(machine + 1, 0);
+    }
+
+    mMachineStartFrames[machine] = frame;
+}
+
+
 /**
  * Save the timeline animation to XML
  * @param root Xml node to save to
@@ -64,8 +80,11 @@ void Timeline::Save(wxXmlNode* root)
 {
     root->AddAttribute(L"numframes", wxString::Format(wxT("%i"), mNumFrames));
     root->AddAttribute(L"framerate", wxString::Format(wxT("%i"), mFrameRate));
-    root->AddAttribute(L"machine1start", wxString::Format(wxT("%i"), mMachine1StartFrame));
-    root->AddAttribute(L"machine2start", wxString::Format(wxT("%i"), mMachine2StartFrame));
+    for (size_t i = 0; i < mMachineStartFrames.size(); i++)
+    {
+        root->AddAttribute(wxString::Format(wxT("machine%istart"), int(i + 1)),
+                wxString::Format(wxT("%i"), mMachineStartFrames[i]));
+    }
 
     for (auto channel : mChannels)
     {
@@ -87,8 +106,16 @@ void Timeline::Load(wxXmlNode* root)
     // Get the attributes
     mNumFrames = wxAtoi(root->GetAttribute(L"numframes", L"300"));
     mFrameRate = wxAtoi(root->GetAttribute(L"framerate", L"30"));
-    mMachine1StartFrame = wxAtoi(root->GetAttribute(L"machine1start", L"0"));
-    mMachine2StartFrame = wxAtoi(root->GetAttribute(L"machine2start", L"0"));
+    for (size_t i = 0; ; i++)
+    {
+        auto name = wxString::Format(wxT("machine%istart"), int(i + 1));
+        if (!root->HasAttribute(name))
+        {
+            break;
+        }
+
+        SetMachineStartFrame(i, wxAtoi(root->GetAttribute(name, L"0")));
+    }
 
     auto child = root->GetChildren();
     for( ; child; child=child->GetNext())
@@ -135,8 +162,7 @@ void Timeline::Clear()
     mCurrentTime = 0;
     mNumFrames = 300;
     mFrameRate = 30;
-    mMachine1StartFrame = 0;
-    mMachine2StartFrame = 0;
+    mMachineStartFrames.clear();
 
     for (auto channel : mChannels)
     {
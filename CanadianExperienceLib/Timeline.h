@@ -25,15 +25,17 @@ private:
     int mFrameRate = 30;        ///< Animation frame rate in frames per second
     double mCurrentTime = 0;    ///< The current animation time
 
-    ///start time for machine 1
-    int mMachine1StartFrame = 0;
-    ///start time for machine 2
-    int mMachine2StartFrame = 0;
+    /// Frame each machine starts running at, by machine index
+    std::vector<int> mMachineStartFrames;
 
     /// List of all animation channels
     std::vector<AnimChannel *> mChannels;
 
 public:
+    /// Fraction of a frame a time may fall short and still
+    /// count as that frame
+    static constexpr double FrameTolerance = 1e-6;
+
     Timeline();
 
     /// Copy constructor (disabled)
@@ -76,10 +78,12 @@ public:
 
     /** Get the current frame.
      *
-     * This is the frame associated with the current time
+     * This is the frame associated with the current time.
+     * A time computed as frame / rate can land a hair below the
+     * frame, so we allow a tiny tolerance before truncating.
      * @return Current frame
      */
-    int GetCurrentFrame() const { return int(mCurrentTime * mFrameRate); }
+    int GetCurrentFrame() const { return int(mCurrentTime * mFrameRate + FrameTolerance); }
 
     /**
      * Get the animation duration
@@ -97,31 +101,23 @@ public:
 
     void Load(wxXmlNode* root);
 
-    /**
- * Set the start frame for machine 1
- * @param frame Starting frame number
- */
-    void SetMachine1StartFrame(int frame) { mMachine1StartFrame = frame; }
-
-    /**
-     * Set the start frame for machine 2
-     * @param frame Starting frame number
-     */
-    void SetMachine2StartFrame(int frame) { mMachine2StartFrame = frame; }
+    void SetMachineStartFrame(size_t machine, int frame);
 
     /**
-     * Get the start frame for machine 1
-     * @return Starting frame number
+     * Get the frame a machine starts running at
+     * @param machine Machine index, 0 for the first machine
+     * @return Starting frame number, 0 if never set
      */
-    int GetMachine1StartFrame() const { return mMachine1StartFrame; }
+    int GetMachineStartFrame(size_t machine) const
+    {
+        return machine < mMachineStartFrames.size() ? mMachineStartFrames[machine] : 0;
+    }
 
     /**
-     * Get the start frame for machine 2
-     * @return Starting frame number
+     * Number of machines with a start frame
+     * @return Machine count
      */
-    int GetMachine2StartFrame() const { return mMachine2StartFrame; }
-
-
+    size_t GetMachineStartFrameCount() const { return mMachineStartFrames.size(); }
 };
 
 #endif //CANADIANEXPERIENCE_TIMELINE_H
@@ -34,14 +34,71 @@ ViewEdit::ViewEdit(wxFrame* parent) :wxScrolledCanvas(parent, wxID_ANY)
     parent->Bind(wxEVT_COMMAND_MENU_SELECTED, &ViewEdit::OnEditRotate, this, XRCID("EditRotate"));
     parent->Bind(wxEVT_UPDATE_UI, &ViewEdit::OnUpdateEditMove, this, XRCID("EditMove"));
     parent->Bind(wxEVT_UPDATE_UI, &ViewEdit::OnUpdateEditRotate, this, XRCID("EditRotate"));
+    parent->Bind(wxEVT_COMMAND_MENU_SELECTED, &ViewEdit::OnViewFrameTiming, this, XRCID("ViewFrameTiming"));
+    parent->Bind(wxEVT_UPDATE_UI, &ViewEdit::OnUpdateViewFrameTiming, this, XRCID("ViewFrameTiming"));
 }
 
 /**
  * Force an update of this window when the picture changes.
+ *
+ * If only some drawables moved, only the area they covered
+ * before and cover now is repainted. A change of animation
+ * time repaints everything, since the machines move too.
+ * So does the frame timing overlay, which changes every frame.
  */
 void ViewEdit::UpdateObserver()
 {
-    Refresh();
+    auto picture = GetPicture();
+    if (picture == nullptr || picture->GetAnimationTime() != mPaintedTime || mShowFrameTiming)
+    {
+        Refresh();
+        return;
+    }
+
+    std::vector<wxRect> bounds;
+    SnapshotBounds(bounds);
+    if (bounds.size() != mPaintedBounds.size())
+    {
+        Refresh();
+        return;
+    }
+
+    wxRect dirty;
+    for (size_t i = 0; i < bounds.size(); i++)
+    {
+        if (bounds[i] != mPaintedBounds[i])
+        {
+            for (auto rect : {bounds[i], mPaintedBounds[i]})
+            {
+                if (!rect.IsEmpty())
+                {
+                    dirty = dirty.IsEmpty() ? rect : dirty.Union(rect);
+                }
+            }
+        }
+    }
+
+    if (!dirty.IsEmpty())
+    {
+        RefreshRect(wxRect(CalcScrolledPosition(dirty.GetTopLeft()), dirty.GetSize()));
+    }
+}
+
+
+/**
+ * Get the current bounds of every drawable in the picture
+ * @param bounds Vector to fill, in picture drawing order
+ */
+void ViewEdit::SnapshotBounds(std::vector<wxRect> &bounds)
+{
+    for (auto actor : *GetPicture())
+    {
+        actor->Place();
+        for (auto drawable : actor->GetDrawables())
+        {
+            bounds.push_back(actor->IsEnabled() ? drawable->GetBoundingBox() : wxRect());
+        }
+    }
 }
 
 
@@ -59,14 +116,31 @@ void ViewEdit::OnPaint(wxPaintEvent& event)
     wxAutoBufferedPaintDC dc(this);
     DoPrepareDC(dc);
 
+    // The part of the picture that needs painting
+    auto update = GetUpdateRegion().GetBox();
+    wxRect dirty(CalcUnscrolledPosition(update.GetTopLeft()), update.GetSize());
+
     wxBrush background(*wxWHITE);
     dc.SetBackground(background);
+    dc.SetClippingRegion(dirty);
     dc.Clear();
 
     // Create a graphics context
     auto graphics = std::shared_ptr<wxGraphicsContext>(wxGraphicsContext::Create( dc ));
+    graphics->Clip(dirty.x, dirty.y, dirty.width, dirty.height);
+
+    GetPicture()->Draw(graphics, dirty);
 
-    GetPicture()->Draw(graphics);
+    if (mShowFrameTiming)
+    {
+        DrawFrameTiming(graphics);
+    }
+
+    // Remember what we painted so the next update
+    // knows what changed
+    mPaintedBounds.clear();
+    SnapshotBounds(mPaintedBounds);
+    mPaintedTime = GetPicture()->GetAnimationTime();
 }
 
 /**
@@ -210,3 +284,55 @@ void ViewEdit::OnUpdateEditRotate(wxUpdateUIEvent& event)
 {
     event.Check(mMode == Mode::Rotate);
 }
+
+
+/**
+ * Handle the View>Frame Timing menu option
+ * @param event The menu event
+ */
+void ViewEdit::OnViewFrameTiming(wxCommandEvent& event)
+{
+    mShowFrameTiming = !mShowFrameTiming;
+    Refresh();
+}
+
+
+/**
+ * Update the user interface for View>Frame Timing
+ * @param event The event we update
+ */
+void ViewEdit::OnUpdateViewFrameTiming(wxUpdateUIEvent& event)
+{
+    event.Check(mShowFrameTiming);
+}
+
+
+/**
+ * Draw the frame timing overlay in the top left of the window
+ * @param graphics Graphics context to draw on
+ */
+void ViewEdit::DrawFrameTiming(std::shared_ptr<wxGraphicsContext> graphics)
+{
+    const int LineHeight = 16;
+    const int Margin = 10;
+
+    auto stats = GetPicture()->GetProfiler()->GetStats();
+    auto topLeft = CalcUnscrolledPosition(wxPoint(Margin, Margin));
+
+    graphics->ResetClip();
+    graphics->SetPen(*wxTRANSPARENT_PEN);
+    graphics->SetBrush(wxBrush(wxColour(0, 0, 0, 160)));
+    graphics->DrawRectangle(topLeft.x, topLeft.y, 250, (stats.size() + 1) * LineHeight + Margin);
+
+    wxFont font(wxSize(0, 12), wxFONTFAMILY_TELETYPE, wxFONTSTYLE_NORMAL, wxFONTWEIGHT_NORMAL);
+    graphics->SetFont(font, *wxWHITE);
+
+    int y = topLeft.y + Margin / 2;
+    graphics->DrawText(L"Stage           p50 ms   p99 ms", topLeft.x + Margin / 2, y);
+    for (const auto &stat : stats)
+    {
+        y += LineHeight;
+        graphics->DrawText(wxString::Format(L"%-14s %7.2f  %7.2f", stat.name, stat.p50, stat.p99),
+                topLeft.x + Margin / 2, y);
+    }
+}
@@ -31,6 +31,8 @@ private:
     void OnEditRotate(wxCommandEvent& event);
     void OnUpdateEditMove(wxUpdateUIEvent& event);
     void OnUpdateEditRotate(wxUpdateUIEvent& event);
+    void OnViewFrameTiming(wxCommandEvent& event);
+    void OnUpdateViewFrameTiming(wxUpdateUIEvent& event);
 
     /// The last mouse position
     wxPoint mLastMouse = wxPoint(0, 0);
@@ -41,6 +43,19 @@ private:
     /// The currently selected drawable
     std::shared_ptr<Drawable> mSelectedDrawable;
 
+    /// Bounds of every drawable when we last painted,
+    /// in picture drawing order
+    std::vector<wxRect> mPaintedBounds;
+
+    /// Animation time when we last painted
+    double mPaintedTime = -1;
+
+    /// Is the frame timing overlay shown?
+    bool mShowFrameTiming = false;
+
+    void SnapshotBounds(std::vector<wxRect> &bounds);
+    void DrawFrameTiming(std::shared_ptr<wxGraphicsContext> graphics);
+
 public:
     /// The current mouse mode
     enum class Mode {Move, Rotate};
@@ -36,6 +36,9 @@ const int BorderLeft = 10;
 /// Space to the right of the scale
 const int BorderRight = 10;
 
+/// Space allowed for a label centered on a tick
+const int LabelMargin = 50;
+
 /// Filename for the pointer image
 const std::wstring PointerImageFile = L"/pointer.png";
 
@@ -50,9 +53,11 @@ ViewTimeline::ViewTimeline(wxFrame* parent, std::wstring imagesDir) :
             wxID_ANY,
             wxDefaultPosition,
             wxSize(100, Height),
-            wxBORDER_SIMPLE)
+            wxBORDER_SIMPLE),
+    mFont(wxSize(0, TickFontSize), wxFONTFAMILY_SWISS, wxFONTSTYLE_NORMAL, wxFONTWEIGHT_NORMAL)
 {
     SetBackgroundStyle(wxBG_STYLE_PAINT);
+    SetScrollRate(1, 0);
 
     mPointerImage = std::make_unique<wxImage>(imagesDir + PointerImageFile, wxBITMAP_TYPE_ANY);
 
@@ -73,16 +78,32 @@ ViewTimeline::ViewTimeline(wxFrame* parent, std::wstring imagesDir) :
     parent->Bind(wxEVT_COMMAND_MENU_SELECTED, &ViewTimeline::OnPlayPlayFromBeginning, this, XRCID("PlayPlayFromBeginning"));
 
     mTimer.SetOwner(this);
-    mStopWatch.Start(0);
-    mStopWatch.Pause();
 }
 
 /**
  * Force an update of this window when the picture changes.
+ *
+ * If only the time changed, only the area under the old
+ * and new pointer is repainted.
  */
 void ViewTimeline::UpdateObserver()
 {
-    Refresh();
+    auto timeline = GetPicture()->GetTimeline();
+    if (mPointerX < 0 || timeline->GetNumFrames() != mTicksFrames ||
+        timeline->GetFrameRate() != mTicksRate)
+    {
+        Refresh();
+    }
+    else
+    {
+        int x = PointerX();
+        if (x != mPointerX)
+        {
+            auto dirty = PointerRect(mPointerX).Union(PointerRect(x));
+            RefreshRect(wxRect(CalcScrolledPosition(dirty.GetTopLeft()), dirty.GetSize()));
+        }
+    }
+
     Update();
 }
 
@@ -94,16 +115,28 @@ void ViewTimeline::OnPaint(wxPaintEvent& event)
 {
     // Get the timeline
     Timeline *timeline = GetPicture()->GetTimeline();
-    int sizeTotal = timeline->GetNumFrames() * TickSpacing + BorderLeft + BorderRight, WindowHeight;
-    SetVirtualSize(sizeTotal, 0);
-    SetScrollRate(1, 0);
+    if (timeline->GetNumFrames() != mTicksFrames)
+    {
+        int sizeTotal = timeline->GetNumFrames() * TickSpacing + BorderLeft + BorderRight;
+        SetVirtualSize(sizeTotal, 0);
+    }
+
+    // The tick marks only change when the timeline or
+    // the visible part of it does
+    wxRect visible(CalcUnscrolledPosition(wxPoint(0, 0)), GetClientSize());
+    if (timeline->GetNumFrames() != mTicksFrames || timeline->GetFrameRate() != mTicksRate ||
+        visible != mTicksRect)
+    {
+        DrawTicks(visible);
+    }
 
     wxAutoBufferedPaintDC dc(this);
     DoPrepareDC(dc);
 
-    wxBrush background(*wxWHITE);
-    dc.SetBackground(background);
-    dc.Clear();
+    if (mTicks.IsOk())
+    {
+        dc.DrawBitmap(mTicks, mTicksRect.GetTopLeft());
+    }
 
     // Create a graphics context
     auto graphics = std::shared_ptr<wxGraphicsContext>(wxGraphicsContext::Create( dc ));
@@ -113,33 +146,67 @@ void ViewTimeline::OnPaint(wxPaintEvent& event)
         mPointerBitmap = graphics->CreateBitmapFromImage(*mPointerImage);
     }
 
-    auto rect = GetClientRect();
-    int hit = rect.GetHeight();
-    int wid = rect.GetWidth();
+    //
+    // Draw the pointer
+    //
+    auto pointer = PointerRect(PointerX());
+    graphics->DrawBitmap(mPointerBitmap,
+            pointer.x, pointer.y,
+            pointer.width, pointer.height
+    );
+
+    mPointerX = PointerX();
+}
+
+/**
+ * Draw the tick marks for part of the timeline into mTicks
+ * @param rect Virtual area of the timeline to draw
+ */
+void ViewTimeline::DrawTicks(const wxRect &rect)
+{
+    Timeline *timeline = GetPicture()->GetTimeline();
+    mTicksRect = rect;
+    mTicksFrames = timeline->GetNumFrames();
+    mTicksRate = timeline->GetFrameRate();
+
+    if (rect.IsEmpty())
+    {
+        mTicks = wxBitmap();
+        return;
+    }
+
+    mTicks = wxBitmap(rect.GetSize());
+    wxMemoryDC dc(mTicks);
 
-    wxFont font(wxSize(0, TickFontSize),
-            wxFONTFAMILY_SWISS,
-            wxFONTSTYLE_NORMAL,
-            wxFONTWEIGHT_NORMAL);
-    graphics->SetFont(font, *wxBLACK);
+    wxBrush background(*wxWHITE);
+    dc.SetBackground(background);
+    dc.Clear();
+
+    auto graphics = std::shared_ptr<wxGraphicsContext>(wxGraphicsContext::Create( dc ));
+    graphics->Translate(-rect.x, -rect.y);
+    graphics->SetFont(mFont, *wxBLACK);
     graphics->SetPen(*wxBLACK_PEN);
 
     int top = TickTop;
 
+    // Only the ticks that can be seen, allowing for
+    // labels that hang over the edges
+    int first = std::max(0, (rect.GetLeft() - BorderLeft - LabelMargin) / TickSpacing);
+    int last = std::min(mTicksFrames, (rect.GetRight() - BorderLeft + LabelMargin) / TickSpacing + 1);
 
-    for (int tickNum = 0; tickNum <= timeline->GetNumFrames(); tickNum++)
+    for (int tickNum = first; tickNum <= last; tickNum++)
     {
         int x = BorderLeft + tickNum * TickSpacing;
         int bottom = top + TickShort;
 
-        bool onSecond = (tickNum % timeline->GetFrameRate()) == 0;
+        bool onSecond = (tickNum % mTicksRate) == 0;
         if (onSecond)
         {
             bottom = top + TickLong;
 
             // Convert the tick number to seconds in a string
             std::wstringstream str;
-            str << tickNum / timeline->GetFrameRate();
+            str << tickNum / mTicksRate;
             std::wstring wstr = str.str();
 
             double w, h;
@@ -150,17 +217,28 @@ void ViewTimeline::OnPaint(wxPaintEvent& event)
 
         graphics->StrokeLine(x, bottom, x, top);
     }
+}
 
-    //
-    // Draw the pointer
-    //
+/**
+ * Get the virtual x location of the pointer for the current time
+ * @return Pointer x location
+ */
+int ViewTimeline::PointerX()
+{
+    Timeline *timeline = GetPicture()->GetTimeline();
+    return BorderLeft + (int)(timeline->GetCurrentTime() * timeline->GetFrameRate() * TickSpacing);
+}
+
+/**
+ * Get the virtual area the pointer covers
+ * @param x Pointer x location
+ * @return Pointer rectangle
+ */
+wxRect ViewTimeline::PointerRect(int x)
+{
     int pw = mPointerImage->GetWidth();
     int ph = mPointerImage->GetHeight();
-    int x = BorderLeft + (int)(timeline->GetCurrentTime() * timeline->GetFrameRate() * TickSpacing);
-    graphics->DrawBitmap(mPointerBitmap,
-            x - pw / 2, top,
-            pw, ph
-    );
+    return wxRect(x - pw / 2, TickTop, pw, ph);
 }
 
 /**
@@ -284,13 +362,7 @@ void ViewTimeline::OnPlayPlay(wxCommandEvent& event)
         return;
     }
 
-    auto timeline = GetPicture()->GetTimeline();
-
-    auto frameRate = timeline->GetFrameRate();
-    auto time = timeline->GetCurrentTime();
-
-    mStopWatch.Start(lround(time * 1000));
-    mTimer.Start(1000 / frameRate);
+    Play();
 }
 
 /**
@@ -305,13 +377,7 @@ void ViewTimeline::OnPlayPlayFromBeginning(wxCommandEvent& event)
     }
 
     GetPicture()->SetAnimationTime(0);
-
-    auto timeline = GetPicture()->GetTimeline();
-
-    auto frameRate = timeline->GetFrameRate();
-
-    mStopWatch.Start(0);
-    mTimer.Start(1000 / frameRate);
+    Play();
 }
 
 /**
@@ -324,25 +390,67 @@ void ViewTimeline::OnPlayStop(wxCommandEvent& event)
 }
 
 
+/**
+ * Start playing from the current frame
+ */
+void ViewTimeline::Play()
+{
+    auto timeline = GetPicture()->GetTimeline();
+
+    mClock.Start(timeline->GetCurrentFrame(), timeline->GetFrameRate());
+    mPlaying = true;
+    ScheduleFrame();
+}
+
+
+/**
+ * Set the timer to go off when the next frame is due
+ */
+void ViewTimeline::ScheduleFrame()
+{
+    auto wait = std::chrono::ceil<std::chrono::milliseconds>(mClock.UntilNext());
+    mTimer.StartOnce(std::max(1, int(wait.count())));
+}
+
+
 /**
  * Handle timer events
+ *
+ * Shows the latest frame that is due. If rendering fell
+ * behind, the frames in between are skipped. The machines
+ * still see every frame, since they run up to the frame
+ * they are set to.
  * @param event timer event
  */
 void ViewTimeline::OnTimer(wxTimerEvent& event)
 {
-    auto timeline = GetPicture()->GetTimeline();
+    if (!mPlaying)
+    {
+        return;
+    }
 
-    auto newTime = mStopWatch.Time() / 1000.0;
-    auto frameRate = timeline->GetFrameRate();
+    auto timeline = GetPicture()->GetTimeline();
+    if (mClock.Advance() == 0)
+    {
+        // Woke up early
+        ScheduleFrame();
+        return;
+    }
 
-    int frame = (int)lround(newTime * frameRate);
+    int frame = mClock.GetFrame();
     if(frame >= timeline->GetNumFrames())
     {
         frame = timeline->GetNumFrames();
         Stop();
     }
 
-    GetPicture()->SetAnimationTime(newTime);
+    GetPicture()->SetAnimationTime((double)frame / timeline->GetFrameRate());
+    ShowPlaybackStatus();
+
+    if (mPlaying)
+    {
+        ScheduleFrame();
+    }
 }
 
 
@@ -353,7 +461,22 @@ void ViewTimeline::Stop()
 {
     mPlaying = false;
     mTimer.Stop();
-    mStopWatch.Pause();
+}
+
+
+/**
+ * Show the playback timing statistics in the status bar
+ */
+void ViewTimeline::ShowPlaybackStatus()
+{
+    auto frame = dynamic_cast<wxFrame *>(GetParent());
+    if (frame == nullptr || frame->GetStatusBar() == nullptr)
+    {
+        return;
+    }
+
+    frame->SetStatusText(wxString::Format(L"%.1f fps, %d dropped, late %.1f ms average, %.1f ms worst",
+            mClock.GetFps(), mClock.GetDroppedFrames(), mClock.GetAverageLateness(), mClock.GetMaxLateness()));
 }
 
 
@@ -388,6 +511,11 @@ void ViewTimeline::OnFileOpen(wxCommandEvent& event)
     }
 
     auto filename = loadFileDialog.GetPath();
-    GetPicture()->Load(filename);
+    if (!GetPicture()->Load(filename))
+    {
+        wxMessageBox(L"Unable to load Animation file");
+        return;
+    }
+
     Refresh();
 }
\ No newline at end of file
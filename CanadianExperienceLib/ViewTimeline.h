@@ -9,6 +9,7 @@
 #define CANADIANEXPERIENCE_VIEWTIMELINE_H
 
 #include "PictureObserver.h"
+#include "PlaybackClock.h"
 
 /**
  * View class for the timeline area of the screen.
@@ -43,12 +44,37 @@ private:
     /// The timer that allows for playing the animation
     wxTimer mTimer;
 
-    /// Stopwatch used to measure elapsed time
-    wxStopWatch mStopWatch;
+    /// Decides which frame to show during playback
+    PlaybackClock mClock;
 
     /// Are we playing?
     bool mPlaying = false;
 
+    /// Font for the tick mark labels
+    wxFont mFont;
+
+    /// Tick marks for the visible part of the timeline
+    wxBitmap mTicks;
+
+    /// Virtual area of the timeline mTicks shows
+    wxRect mTicksRect;
+
+    /// Number of frames mTicks was drawn for
+    int mTicksFrames = -1;
+
+    /// Frame rate mTicks was drawn for
+    int mTicksRate = -1;
+
+    /// Virtual x location of the pointer when last painted
+    int mPointerX = -1;
+
+    void DrawTicks(const wxRect &rect);
+    int PointerX();
+    wxRect PointerRect(int x);
+    void Play();
+    void ScheduleFrame();
+    void ShowPlaybackStatus();
+
 public:
     static const int Height = 90;      ///< Height to make this window
 
@@ -61,6 +87,13 @@ public:
 
     void Stop();
 
+    /**
+     * Get the playback clock, which holds the timing
+     * statistics for the current or last playback
+     * @return Playback clock
+     */
+    const PlaybackClock &GetClock() const { return mClock; }
+
 
 };
 
@@ -0,0 +1,137 @@
+/**
+ * @file FrameExportApp.cpp
+ * @author Shane Carr
+ */
+
+#include "pch.h"
+
+#include <wx/filename.h>
+
+#include "FrameExportApp.h"
+#include <Picture.h>
+#include <Timeline.h>
+#include <FrameExporter.h>
+#include <image-cache.h>
+
+/// Command line options
+static const wxCmdLineEntryDesc CommandLine[] =
+{
+    { wxCMD_LINE_SWITCH, "h", "help", "Show this help", wxCMD_LINE_VAL_STRING, wxCMD_LINE_OPTION_HELP },
+    { wxCMD_LINE_OPTION, "r", "resources", "Resources directory (default .)", wxCMD_LINE_VAL_STRING, 0 },
+    { wxCMD_LINE_OPTION, "o", "output", "Output directory (default frames)", wxCMD_LINE_VAL_STRING, 0 },
+    { wxCMD_LINE_OPTION, "s", "start", "First frame to export (default 0)", wxCMD_LINE_VAL_NUMBER, 0 },
+    { wxCMD_LINE_OPTION, "e", "end", "Last frame to export (default last frame)", wxCMD_LINE_VAL_NUMBER, 0 },
+    { wxCMD_LINE_OPTION, "j", "threads", "Worker threads (default one per core)", wxCMD_LINE_VAL_NUMBER, 0 },
+    { wxCMD_LINE_SWITCH, "w", "software", "Draw with the software rasterizer", wxCMD_LINE_VAL_NONE, 0 },
+    { wxCMD_LINE_PARAM, nullptr, nullptr, "animation file", wxCMD_LINE_VAL_STRING, 0 },
+    { wxCMD_LINE_NONE }
+};
+
+
+/**
+ * Initialize the application.
+ * @return True if successful
+ */
+bool FrameExportApp::OnInit()
+{
+    if (!wxAppConsole::OnInit())
+        return false;
+
+    wxInitAllImageHandlers();
+    return true;
+}
+
+
+/**
+ * Exit the application.
+ *
+ * Releases the cached bitmaps before the graphics renderer
+ * shuts down.
+ * @return Exit code
+ */
+int FrameExportApp::OnExit()
+{
+    ImageCache::Get().Clear();
+    return wxAppConsole::OnExit();
+}
+
+
+/**
+ * Describe the command line to the parser
+ * @param parser Command line parser
+ */
+void FrameExportApp::OnInitCmdLine(wxCmdLineParser& parser)
+{
+    parser.SetDesc(CommandLine);
+}
+
+
+/**
+ * Collect the parsed command line options
+ * @param parser Command line parser
+ * @return True if the options are usable
+ */
+bool FrameExportApp::OnCmdLineParsed(wxCmdLineParser& parser)
+{
+    wxString value;
+    if (parser.Found(L"r", &value))
+        mResourcesDir = value.ToStdWstring();
+
+    if (parser.Found(L"o", &value))
+        mOutputDir = value.ToStdWstring();
+
+    parser.Found(L"s", &mStartFrame);
+    parser.Found(L"e", &mEndFrame);
+    parser.Found(L"j", &mThreads);
+    mSoftware = parser.Found(L"w");
+
+    mAnimFile = parser.GetParam(0).ToStdWstring();
+    return true;
+}
+
+
+/**
+ * Export the frames
+ * @return Process exit code
+ */
+int FrameExportApp::OnRun()
+{
+    if (!wxFileExists(mAnimFile))
+    {
+        wxLogError(L"Animation file %s not found", mAnimFile);
+        return 1;
+    }
+
+    wxFileName::Mkdir(mOutputDir, wxS_DIR_DEFAULT, wxPATH_MKDIR_FULL);
+
+    // Only need the timeline to know how many frames there are
+    Picture picture;
+    if (!picture.Load(mAnimFile))
+    {
+        wxLogError(L"Unable to load animation file %s", mAnimFile);
+        return 1;
+    }
+    long last = picture.GetTimeline()->GetNumFrames() - 1;
+    long end = mEndFrame < 0 ? last : std::min(mEndFrame, last);
+
+    FrameExporter exporter(mResourcesDir, mAnimFile);
+    if (mThreads > 0)
+    {
+        exporter.SetThreads(mThreads);
+    }
+
+    exporter.SetSoftware(mSoftware);
+
+    if (!exporter.Export(mStartFrame, end, mOutputDir))
+    {
+        if (!exporter.GetError().empty())
+        {
+            wxLogError(L"%s", exporter.GetError());
+        }
+
+        wxLogError(L"Export to %s failed", mOutputDir);
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,49 @@
+/**
+ * @file FrameExportApp.h
+ * @author Shane Carr
+ *
+ * Console application that exports animation frames as images.
+ */
+
+#ifndef CANADIANEXPERIENCE_FRAMEEXPORTAPP_H
+#define CANADIANEXPERIENCE_FRAMEEXPORTAPP_H
+
+#include <wx/cmdline.h>
+
+/**
+ * Console application that exports animation frames as images.
+ *
+ * Usage: FrameExport [options] movie.anim
+ */
+class FrameExportApp : public wxAppConsole {
+private:
+    /// Directory containing the images and machine resources
+    std::wstring mResourcesDir = L".";
+
+    /// Animation file to load
+    std::wstring mAnimFile;
+
+    /// Directory to write frames into
+    std::wstring mOutputDir = L"frames";
+
+    /// First frame to write
+    long mStartFrame = 0;
+
+    /// Last frame to write, or -1 for the end of the animation
+    long mEndFrame = -1;
+
+    /// Number of worker threads, 0 for one per core
+    long mThreads = 0;
+
+    /// Draw with the software rasterizer
+    bool mSoftware = false;
+
+public:
+    bool OnInit() override;
+    int OnExit() override;
+    void OnInitCmdLine(wxCmdLineParser& parser) override;
+    bool OnCmdLineParsed(wxCmdLineParser& parser) override;
+    int OnRun() override;
+};
+
+#endif //CANADIANEXPERIENCE_FRAMEEXPORTAPP_H
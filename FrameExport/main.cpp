@@ -0,0 +1,10 @@
+/**
+ * @file main.cpp
+ * @author Shane Carr
+ *
+ * Main entry point for the frame export tool
+ */
+#include "pch.h"
+#include "FrameExportApp.h"
+
+wxIMPLEMENT_APP_CONSOLE(FrameExportApp);
@@ -0,0 +1,98 @@
+/**
+ * @file main.cpp
+ * @author Shane Carr
+ *
+ * Benchmark of the grouped component loops against the
+ * virtual ones.
+ *
+ * Steps, evaluates and updates the machine for a number of
+ * frames each way and prints the time per frame. Like the
+ * tests, it runs from its own build directory and finds the
+ * machine images one level up. An optional argument sets the
+ * number of frames.
+ */
+
+#include "pch.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <wx/filefn.h>
+#include <wx/init.h>
+
+#include <MachineSystem.h>
+#include <Machine.h>
+
+using namespace std::chrono;
+
+/// Frame time the machine is stepped at
+const double FrameDelta = 1.0 / 30;
+
+/// Number of frames to time if not given
+const int DefaultFrames = 100000;
+
+/**
+ * Time stepping, evaluating and updating a machine every frame
+ * @param machine Machine to step, reset before and after
+ * @param frames Number of frames to step
+ * @return Time taken
+ */
+static nanoseconds TimeSteps(std::shared_ptr<Machine> machine, int frames)
+{
+    machine->Reset();
+
+    auto start = steady_clock::now();
+    for (int frame = 1; frame <= frames; frame++)
+    {
+        machine->Step(FrameDelta, frame * FrameDelta);
+        machine->Evaluate(frame * FrameDelta);
+        machine->Update(FrameDelta);
+    }
+
+    auto taken = steady_clock::now() - start;
+    machine->Reset();
+    return duration_cast<nanoseconds>(taken);
+}
+
+/**
+ * Main entry point
+ * @param argc Number of arguments
+ * @param argv Arguments, optionally the number of frames
+ * @return Exit code
+ */
+int main(int argc, char **argv)
+{
+    wxInitializer initializer;
+    if (!initializer.IsOk())
+    {
+        std::cerr << "Unable to initialize wxWidgets" << std::endl;
+        return 1;
+    }
+
+    wxSetWorkingDirectory(L"..");
+    wxInitAllImageHandlers();
+
+    int frames = argc > 1 ? std::max(std::stoi(argv[1]), 1) : DefaultFrames;
+
+    MachineSystem system(L".");
+    auto machine = system.GetMachine();
+    if (!machine->GetDefinition()->GetGroups().IsGrouped())
+    {
+        std::cout << "Machine can't be grouped, both runs use the virtual loops" << std::endl;
+    }
+
+    // Once each way first so neither run pays for warming up
+    machine->SetGrouped(false);
+    TimeSteps(machine, frames / 10);
+    auto virtuals = TimeSteps(machine, frames);
+
+    machine->SetGrouped(true);
+    TimeSteps(machine, frames / 10);
+    auto grouped = TimeSteps(machine, frames);
+
+    std::cout << "Frames:  " << frames << std::endl;
+    std::cout << "Virtual: " << virtuals.count() / frames << " ns/frame" << std::endl;
+    std::cout << "Grouped: " << grouped.count() / frames << " ns/frame" << std::endl;
+    return 0;
+}
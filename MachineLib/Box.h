@@ -17,6 +17,19 @@
 class Box : public Component, public IKeyFall
 {
 private:
+    /// Simulation state of the box
+    struct BoxState : ComponentState
+    {
+        /// Boolean to know if the lid is open
+        bool open = false;
+
+        /// Frames the lid has been opening for
+        int openFrames = 0;
+
+        /// Angle the lid is shown
+        double lidAngle = 0;
+    };
+
     /// The box background image
     cse335::Polygon mBox;
 
@@ -29,9 +42,6 @@ private:
     /// Size of the lid
     int mLidSize;
 
-    /// Boolean to know if the lid is open
-    bool mOpen = false;
-
     /// Back plate of the box
     std::unique_ptr<cse335::Polygon> mBack;
 
@@ -41,9 +51,6 @@ private:
     /// Lid of the box
     cse335::Polygon mLid;
 
-    /// Angle the lid is shown
-    double mLidAngle = 0;
-
 public:
     /**
      * Constructor for the Box class.
@@ -71,6 +78,18 @@ public:
      */
     void Draw(std::shared_ptr<wxGraphicsContext> graphics) override;
 
+    /**
+     * Draw the box and its lid with the software rasterizer.
+     * @param rasterizer Rasterizer to draw into.
+     */
+    void Rasterize(SoftwareRasterizer &rasterizer) override;
+
+    /**
+     * Draw the front of the box with the software rasterizer.
+     * @param rasterizer Rasterizer to draw into.
+     */
+    void RasterizeForeground(SoftwareRasterizer &rasterizer) override;
+
     /**
      * Handle the key fall event.
      */
@@ -93,10 +112,19 @@ public:
      */
     void Advance(double delta) override;
 
+    /**
+     * Advance the box a number of frames at once.
+     * @param frames Number of frames to advance
+     * @param delta Frame time in seconds
+     * @param time Machine time at the end of the last frame
+     */
+    void FastForward(int frames, double delta, double time) override;
+
     /**
      * Reset the box to its initial state.
      */
     void Reset() override;
+
 };
 
 #endif //CANADIANEXPERIENCE_MACHINELIB_BOX_H
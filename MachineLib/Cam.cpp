@@ -4,10 +4,13 @@
  */
 #include "pch.h"
 #include "Cam.h"
+#include "SoftwareRasterizer.h"
 
 
 Cam::Cam(const std::wstring& imagesDir)
 {
+    InitState<CamState>();
+
     // Configure the key
     mKey.SetImage(imagesDir + KeyImage);
     mKey.Rectangle(-KeyImageSize/2, 0, KeyImageSize, KeyImageSize);
@@ -15,23 +18,25 @@ Cam::Cam(const std::wstring& imagesDir)
 
 void Cam::Draw(std::shared_ptr<wxGraphicsContext> graphics)
 {
+    const auto &state = GetState<CamState>();
+
     graphics->PushState();
     graphics->Translate(GetX(), GetY());
 
     // Draw the key
     double baseKeyY =  -CamDiameter/2;  // This puts bottom of key at cam's top
-    double dropDistance = mKeyDropped ? KeyDrop : 0;  // Drop by KeyDrop when triggered
+    double dropDistance = state.keyDropped ? KeyDrop : 0;  // Drop by KeyDrop when triggered
 
     mKey.DrawPolygon(graphics, 0, baseKeyY + dropDistance);
 
     // Draw the cam body
-    wxBrush brush(*wxWHITE);
-    wxPen pen(*wxBLACK);
+    wxBrush brush(wxColour(255, 255, 255));
+    wxPen pen(wxColour(0, 0, 0));
     graphics->SetBrush(brush);
     graphics->SetPen(pen);
     graphics->DrawRectangle(-CamWidth/2, -CamDiameter/2, CamWidth, CamDiameter);
 
-    if (mRotation <= 1.0)
+    if (state.rotation <= 1.0)
     {
         // Start at bottom inside the rectangle and adjust travel distance
         double startY = (CamDiameter/2) - 10;  // Start 10 pixels in from bottom
@@ -39,16 +44,17 @@ void Cam::Draw(std::shared_ptr<wxGraphicsContext> graphics)
         double totalDistance = startY - endY;   // Total distance to travel
 
         // Calculate current position
-        double holeY = startY - (mRotation * totalDistance);
+        double holeY = startY - (state.rotation * totalDistance);
 
         double holeHeight = HoleSize;
-        if (mRotation > 0.9)
+        if (state.rotation > 0.9)
         {
-            double scaleProgress = (mRotation - 0.9) * 10;
+            double scaleProgress = (state.rotation - 0.9) * 10;
             holeHeight = HoleSize * (1.0 - scaleProgress);
             holeHeight = std::max(holeHeight, 2.0);
         }
-        graphics->SetBrush(*wxBLACK_BRUSH);
+        wxBrush holeBrush(wxColour(0, 0, 0));
+        graphics->SetBrush(holeBrush);
         graphics->DrawEllipse(-HoleSize/2, holeY, HoleSize, holeHeight);
     }
 
@@ -60,12 +66,13 @@ void Cam::Draw(std::shared_ptr<wxGraphicsContext> graphics)
 
 void Cam::SetRotation(double rotation)
 {
-    mRotation = rotation;
+    auto &state = GetState<CamState>();
+    state.rotation = rotation;
 
     // When dot reaches top (rotation = 1.0), trigger key fall
-    if (mRotation >= 1.0 && !mKeyDropped)
+    if (state.rotation >= KeyFallRotation && !state.keyDropped)
     {
-        mKeyDropped = true;
+        state.keyDropped = true;
         for(auto listener : mKeyFallListeners)
         {
             listener->KeyFall();
@@ -77,6 +84,49 @@ void Cam::DrawForeground(std::shared_ptr<wxGraphicsContext> graphics)
 {
 }
 
+void Cam::Rasterize(SoftwareRasterizer &rasterizer)
+{
+    const auto &state = GetState<CamState>();
+
+    rasterizer.PushState();
+    rasterizer.Translate(GetX(), GetY());
+
+    // Draw the key
+    double baseKeyY =  -CamDiameter/2;  // This puts bottom of key at cam's top
+    double dropDistance = state.keyDropped ? KeyDrop : 0;  // Drop by KeyDrop when triggered
+
+    mKey.Rasterize(rasterizer, 0, baseKeyY + dropDistance);
+
+    // Draw the cam body
+    double left = -CamWidth/2;
+    double top = -CamDiameter/2;
+    rasterizer.FillPolygon({wxPoint2DDouble(left, top), wxPoint2DDouble(left + CamWidth, top),
+                            wxPoint2DDouble(left + CamWidth, top + CamDiameter),
+                            wxPoint2DDouble(left, top + CamDiameter)}, wxColour(255, 255, 255));
+    rasterizer.StrokeRectangle(left, top, CamWidth, CamDiameter, 1, wxColour(0, 0, 0));
+
+    if (state.rotation <= 1.0)
+    {
+        // The hole moves and shrinks just like in Draw
+        double startY = (CamDiameter/2) - 10;
+        double endY = (-CamDiameter/2);
+        double totalDistance = startY - endY;
+
+        double holeY = startY - (state.rotation * totalDistance);
+
+        double holeHeight = HoleSize;
+        if (state.rotation > 0.9)
+        {
+            double scaleProgress = (state.rotation - 0.9) * 10;
+            holeHeight = HoleSize * (1.0 - scaleProgress);
+            holeHeight = std::max(holeHeight, 2.0);
+        }
+        rasterizer.FillEllipse(-HoleSize/2, holeY, HoleSize, holeHeight, wxColour(0, 0, 0));
+    }
+
+    rasterizer.PopState();
+}
+
 void Cam::Update(double elapsed)
 {
     // Nothing to update - rotation comes from source
@@ -87,6 +137,8 @@ void Cam::Reset()
     Component::Reset();  // Call base class reset
 
     // Reset cam-specific values
-    mRotation = 0;
-    mKeyDropped = false;
-}
\ No newline at end of file
+    auto &state = GetState<CamState>();
+    state.rotation = 0;
+    state.keyDropped = false;
+}
+
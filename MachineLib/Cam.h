@@ -31,6 +31,9 @@ const int KeyImageSize = 20;
 /// The amount the key drops into the hole
 const int KeyDrop = 10;
 
+/// Cam rotation in turns at which the key falls into the hole
+const double KeyFallRotation = 1.0;
+
 /**
  * Class that represents the cam component.
  *
@@ -39,15 +42,19 @@ const int KeyDrop = 10;
 class Cam : public Component, public RotationSink
 {
 private:
-    /// Current rotation of the cam
-    double mRotation = 0;
+    /// Simulation state of the cam
+    struct CamState : ComponentState
+    {
+        /// Current rotation of the cam
+        double rotation = 0;
+
+        /// Has the key dropped into the cam hole?
+        bool keyDropped = false;
+    };
 
     /// The key image
     cse335::Polygon mKey;
 
-    /// Has the key dropped into the cam hole?
-    bool mKeyDropped = false;
-
     /// List of components that listen for the key fall event
     std::vector<IKeyFall*> mKeyFallListeners;
 
@@ -70,12 +77,48 @@ public:
      */
     void DrawForeground(std::shared_ptr<wxGraphicsContext> graphics) override;
 
+    /**
+     * Draw the cam component with the software rasterizer.
+     * @param rasterizer Rasterizer to draw into.
+     */
+    void Rasterize(SoftwareRasterizer &rasterizer) override;
+
+    /**
+     * Draw the cam's foreground with the software rasterizer.
+     * @param rasterizer Rasterizer to draw into.
+     */
+    void RasterizeForeground(SoftwareRasterizer &rasterizer) override {}
+
     /**
      * Update the cam's state based on elapsed time.
      * @param elapsed Elapsed time in seconds since last update.
      */
     void Update(double elapsed) override;
 
+    /**
+     * The cam only turns with its rotation source.
+     * @return true
+     */
+    bool IsAnalytic() const override { return true; }
+
+    /**
+     * Has the key still to fall on anyone?
+     * @return true if the key has not dropped and someone is listening
+     */
+    bool HasPendingEvents() const override
+    {
+        return !GetState<CamState>().keyDropped && !mKeyFallListeners.empty();
+    }
+
+    /**
+     * Get the rotation at which the key falls.
+     * @return Rotation in turns, or nothing if the key will not fall on anyone
+     */
+    std::optional<double> GetTriggerRotation() const override
+    {
+        return HasPendingEvents() ? std::optional<double>(KeyFallRotation) : std::nullopt;
+    }
+
     /**
      * Set the cam's rotation angle.
      * @param rotation New rotation angle.
@@ -90,6 +133,7 @@ public:
 
     /// Reset the cam to its initial state.
     void Reset() override;
+
 };
 
 #endif //CANADIANEXPERIENCE_MACHINELIB_CAM_H
@@ -6,6 +6,47 @@
 #include "Component.h"
 Component::Component()
 {
+    InitState<ComponentState>();
+}
+
+
+/**
+ * Advance the component a number of frames at once.
+ *
+ * The component ends up exactly as if it had been stepped
+ * frame by frame with Advance, and its time is set to the
+ * machine time at the end of the last frame. This version
+ * does step frame by frame. Components with a closed form
+ * override it to get there in one go, and step with it too,
+ * so either way gives the same result.
+ * @param frames Number of frames to advance
+ * @param delta Frame time in seconds
+ * @param time Machine time at the end of the last frame
+ */
+void Component::FastForward(int frames, double delta, double time)
+{
+    for (int i = 0; i < frames; i++)
+    {
+        Advance(delta);
+    }
 
+    SetTime(time);
 }
 
+
+/**
+ * Move our state into another block, the machine's when
+ * the component is added to a machine.
+ * @param block Block to move to
+ */
+void Component::MoveState(std::shared_ptr<MachineState> block)
+{
+    if (block == mStateBlock)
+    {
+        return;
+    }
+
+    auto data = mStateBlock->GetData() + mStateOffset;
+    mStateOffset = block->Allocate(data, mStateSize, mStateAlign);
+    mStateBlock = block;
+}
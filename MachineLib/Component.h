@@ -0,0 +1,253 @@
+/**
+ * @file Component.h
+ * @author Shane Carr
+ *
+ * Base class for the components of a machine.
+ */
+
+#ifndef CANADIANEXPERIENCE_MACHINELIB_COMPONENT_H
+#define CANADIANEXPERIENCE_MACHINELIB_COMPONENT_H
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "MachineState.h"
+
+class RotationSource;
+class SoftwareRasterizer;
+
+/**
+ * An event predicted to happen at a machine time, such as
+ * the cam key falling.
+ */
+struct MachineEvent
+{
+    /// Machine time the event is predicted for in seconds
+    double time = 0;
+
+    /// Order the event was predicted in, breaks ties
+    int order = 0;
+
+    /**
+     * Does this event come after another?
+     * @param other Event to compare to
+     * @return true if later
+     */
+    bool operator>(const MachineEvent &other) const
+    {
+        return time > other.time || (time == other.time && order > other.order);
+    }
+};
+
+/**
+ * The simulation state every component has.
+ *
+ * Derived components extend it with a struct of their own,
+ * which must stay trivially copyable.
+ */
+struct ComponentState
+{
+    /// Time this component has been running in seconds
+    double time = 0;
+};
+
+/**
+ * Base class for the components of a machine.
+ *
+ * A component has a position relative to the machine and a
+ * time that advances as the machine runs.
+ *
+ * The simulation state lives in a MachineState block. A new
+ * component has a block of its own, and moves its state into
+ * the machine's block when added to a machine.
+ */
+class Component
+{
+private:
+    /// X position relative to the machine
+    double mX = 0;
+
+    /// Y position relative to the machine
+    double mY = 0;
+
+    /// Block our state lives in
+    std::shared_ptr<MachineState> mStateBlock;
+
+    /// Offset of our state in the block
+    size_t mStateOffset = 0;
+
+    /// Size of our state in bytes
+    size_t mStateSize = 0;
+
+    /// Alignment of our state
+    size_t mStateAlign = 1;
+
+    /// Offset of the ComponentState within our state
+    size_t mBaseOffset = 0;
+
+protected:
+    /**
+     * Give the component its own state struct. Called from
+     * the constructor of derived components.
+     * @tparam T State struct, derived from ComponentState
+     */
+    template <class T>
+    void InitState()
+    {
+        static_assert(std::is_base_of_v<ComponentState, T>, "Component state must extend ComponentState");
+
+        mStateBlock = std::make_shared<MachineState>();
+        mStateOffset = mStateBlock->Create<T>();
+
+        auto &state = mStateBlock->At<T>(mStateOffset);
+        auto base = static_cast<ComponentState *>(&state);
+        mBaseOffset = size_t(reinterpret_cast<std::byte *>(base) - reinterpret_cast<std::byte *>(&state));
+
+        mStateSize = sizeof(T);
+        mStateAlign = alignof(T);
+    }
+
+    /**
+     * Get the state of the component
+     * @tparam T State struct given to InitState
+     * @return Reference to the state
+     */
+    template <class T>
+    T &GetState() { return mStateBlock->At<T>(mStateOffset); }
+
+    /**
+     * Get the state of the component
+     * @tparam T State struct given to InitState
+     * @return Reference to the state
+     */
+    template <class T>
+    const T &GetState() const { return mStateBlock->At<T>(mStateOffset); }
+
+    /**
+     * Set the time this component has been running
+     * @param time Time in seconds
+     */
+    void SetTime(double time) { mStateBlock->At<ComponentState>(mStateOffset + mBaseOffset).time = time; }
+
+public:
+    Component();
+
+    /// Destructor
+    virtual ~Component() = default;
+
+    /// Copy constructor (disabled)
+    Component(const Component &) = delete;
+
+    /// Assignment operator (disabled)
+    void operator=(const Component &) = delete;
+
+    /**
+     * Set the position of the component
+     * @param x X position relative to the machine
+     * @param y Y position relative to the machine
+     */
+    void SetPosition(double x, double y) { mX = x; mY = y; }
+
+    /**
+     * Get the X position
+     * @return X position relative to the machine
+     */
+    double GetX() const { return mX; }
+
+    /**
+     * Get the Y position
+     * @return Y position relative to the machine
+     */
+    double GetY() const { return mY; }
+
+    /**
+     * Get the time this component has been running
+     * @return Time in seconds
+     */
+    double GetTime() const { return mStateBlock->At<ComponentState>(mStateOffset + mBaseOffset).time; }
+
+    /**
+     * Draw the component
+     * @param graphics Graphics context to draw on
+     */
+    virtual void Draw(std::shared_ptr<wxGraphicsContext> graphics) = 0;
+
+    /**
+     * Draw anything that goes in front of the other components
+     * @param graphics Graphics context to draw on
+     */
+    virtual void DrawForeground(std::shared_ptr<wxGraphicsContext> graphics) = 0;
+
+    /**
+     * Draw the component with the software rasterizer
+     * @param rasterizer Rasterizer to draw into
+     */
+    virtual void Rasterize(SoftwareRasterizer &rasterizer) = 0;
+
+    /**
+     * Draw the foreground with the software rasterizer
+     * @param rasterizer Rasterizer to draw into
+     */
+    virtual void RasterizeForeground(SoftwareRasterizer &rasterizer) = 0;
+
+    /**
+     * Update the component
+     * @param elapsed Time since the last update in seconds
+     */
+    virtual void Update(double elapsed) = 0;
+
+    /**
+     * Advance the component in time
+     * @param delta Amount of time to advance in seconds
+     */
+    virtual void Advance(double delta) { SetTime(GetTime() + delta); }
+
+    virtual void FastForward(int frames, double delta, double time);
+
+    /**
+     * Reset the component to its initial state
+     */
+    virtual void Reset() { SetTime(0); }
+
+    /**
+     * Is the state of this component a function of machine time?
+     *
+     * Analytic components are evaluated directly at a time with
+     * Evaluate instead of being stepped frame by frame.
+     * @return true if analytic
+     */
+    virtual bool IsAnalytic() const { return false; }
+
+    /**
+     * Set the state of an analytic component for a machine time
+     * @param time Machine time in seconds
+     */
+    virtual void Evaluate(double time) { SetTime(time); }
+
+    /**
+     * Can this component still fire events to other components?
+     *
+     * While it can, it has to be evaluated every frame so the
+     * events happen on the right frame.
+     * @return true if events are pending
+     */
+    virtual bool HasPendingEvents() const { return false; }
+
+    /**
+     * Get the rotation source if this component drives a
+     * rotation network without being driven itself
+     * @return Source or null
+     */
+    virtual RotationSource *GetRotationDriver() { return nullptr; }
+
+    /**
+     * Predict when the events this component causes will happen
+     * @param events Collection to add predicted events to
+     */
+    virtual void PredictEvents(std::vector<MachineEvent> &events) {}
+
+    void MoveState(std::shared_ptr<MachineState> block);
+};
+
+#endif //CANADIANEXPERIENCE_MACHINELIB_COMPONENT_H
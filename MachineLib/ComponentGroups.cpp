@@ -0,0 +1,309 @@
+/**
+ * @file ComponentGroups.cpp
+ * @author Shane Carr
+ */
+
+#include "pch.h"
+#include "ComponentGroups.h"
+#include "Box.h"
+#include "Sparty.h"
+#include "Crank.h"
+#include "Shaft.h"
+#include "Pulley.h"
+#include "Cam.h"
+
+/// Box::Update does nothing
+template <>
+struct ComponentHooks<Box>
+{
+    static constexpr bool Update = false;
+    static constexpr bool DrawForeground = true;
+};
+
+/// Sparty moves in Advance and only draws in Draw
+template <>
+struct ComponentHooks<Sparty>
+{
+    static constexpr bool Update = false;
+    static constexpr bool DrawForeground = false;
+};
+
+/// The crank turns in Advance and draws nothing in front
+template <>
+struct ComponentHooks<Crank>
+{
+    static constexpr bool Update = false;
+    static constexpr bool DrawForeground = false;
+};
+
+/// Shafts are turned by the crank and draw nothing in front
+template <>
+struct ComponentHooks<Shaft>
+{
+    static constexpr bool Update = false;
+    static constexpr bool DrawForeground = false;
+};
+
+/// Pulleys are turned by their source and draw their belts in front
+template <>
+struct ComponentHooks<Pulley>
+{
+    static constexpr bool Update = false;
+    static constexpr bool DrawForeground = true;
+};
+
+/// The cam is turned by the crank and draws nothing in front
+template <>
+struct ComponentHooks<Cam>
+{
+    static constexpr bool Update = false;
+    static constexpr bool DrawForeground = false;
+};
+
+
+/**
+ * Step the components of one group a frame
+ * @tparam T Component type
+ * @param group Components of the type
+ * @param delta Frame time in seconds
+ * @param time Machine time at the end of the frame
+ * @param evaluate Evaluate the analytic components?
+ */
+template <class T>
+static void StepGroup(const std::vector<T *> &group, double delta, double time, bool evaluate)
+{
+    for (auto component : group)
+    {
+        if (!component->T::IsAnalytic())
+        {
+            component->T::FastForward(1, delta, time);
+        }
+        else if (evaluate)
+        {
+            component->T::Evaluate(time);
+        }
+    }
+}
+
+
+/**
+ * Add a component
+ * @param component Component to add, owned by the machine definition
+ */
+void ComponentGroups::Add(Component *component)
+{
+    Ref ref = component;
+    if (auto box = dynamic_cast<Box *>(component))
+    {
+        ref = box;
+        std::get<std::vector<Box *>>(mGroups).push_back(box);
+    }
+    else if (auto sparty = dynamic_cast<Sparty *>(component))
+    {
+        ref = sparty;
+        std::get<std::vector<Sparty *>>(mGroups).push_back(sparty);
+    }
+    else if (auto crank = dynamic_cast<Crank *>(component))
+    {
+        ref = crank;
+        std::get<std::vector<Crank *>>(mGroups).push_back(crank);
+    }
+    else if (auto shaft = dynamic_cast<Shaft *>(component))
+    {
+        ref = shaft;
+        std::get<std::vector<Shaft *>>(mGroups).push_back(shaft);
+    }
+    else if (auto pulley = dynamic_cast<Pulley *>(component))
+    {
+        ref = pulley;
+        std::get<std::vector<Pulley *>>(mGroups).push_back(pulley);
+    }
+    else if (auto cam = dynamic_cast<Cam *>(component))
+    {
+        ref = cam;
+        std::get<std::vector<Cam *>>(mGroups).push_back(cam);
+    }
+    else
+    {
+        // Unknown types only go through the virtual loops
+        mGrouped = false;
+    }
+
+    mOrdered.push_back(ref);
+
+    if (component->IsAnalytic())
+    {
+        mAnalytic = true;
+    }
+    else if (mAnalytic)
+    {
+        // Grouping would move it ahead of analytic components
+        mGrouped = false;
+    }
+}
+
+
+/**
+ * Step the machine one frame, group by group.
+ *
+ * See Machine::Step.
+ * @param delta Frame time in seconds
+ * @param time Machine time at the end of the frame
+ * @param evaluate Evaluate the analytic components?
+ */
+void ComponentGroups::Step(double delta, double time, bool evaluate)
+{
+    std::apply([=](const auto &... groups) { (StepGroup(groups, delta, time, evaluate), ...); }, mGroups);
+}
+
+
+/**
+ * Advance the stateful components a number of frames at once.
+ *
+ * See Machine::FastForward.
+ * @param frames Number of frames to advance
+ * @param delta Frame time in seconds
+ * @param time Machine time at the end of the last frame
+ */
+void ComponentGroups::FastForward(int frames, double delta, double time)
+{
+    std::apply([=](const auto &... groups) {
+        auto forward = [=](const auto &group) {
+            for (auto component : group)
+            {
+                using T = std::remove_pointer_t<std::decay_t<decltype(component)>>;
+                if (!component->T::IsAnalytic())
+                {
+                    component->T::FastForward(frames, delta, time);
+                }
+            }
+        };
+
+        (forward(groups), ...);
+    }, mGroups);
+}
+
+
+/**
+ * Evaluate all of the analytic components at a machine time
+ * @param time Machine time in seconds
+ */
+void ComponentGroups::Evaluate(double time)
+{
+    std::apply([=](const auto &... groups) {
+        auto evaluate = [=](const auto &group) {
+            for (auto component : group)
+            {
+                using T = std::remove_pointer_t<std::decay_t<decltype(component)>>;
+                if (component->T::IsAnalytic())
+                {
+                    component->T::Evaluate(time);
+                }
+            }
+        };
+
+        (evaluate(groups), ...);
+    }, mGroups);
+}
+
+
+/**
+ * Update the components, skipping the types whose Update
+ * does nothing
+ * @param elapsed Time since the last update in seconds
+ */
+void ComponentGroups::Update(double elapsed)
+{
+    std::apply([=](const auto &... groups) {
+        auto update = [=](const auto &group) {
+            using T = std::remove_pointer_t<typename std::decay_t<decltype(group)>::value_type>;
+            if constexpr (ComponentHooks<T>::Update)
+            {
+                for (auto component : group)
+                {
+                    component->T::Update(elapsed);
+                }
+            }
+        };
+
+        (update(groups), ...);
+    }, mGroups);
+}
+
+
+/**
+ * Draw the components in the order they were added, then
+ * the foregrounds of the ones that have any
+ * @param graphics Graphics context to draw on
+ */
+void ComponentGroups::Draw(std::shared_ptr<wxGraphicsContext> graphics)
+{
+    for (const auto &ref : mOrdered)
+    {
+        std::visit([&graphics](auto component) {
+            using T = std::remove_pointer_t<decltype(component)>;
+            if constexpr (std::is_same_v<T, Component>)
+            {
+                component->Draw(graphics);
+            }
+            else
+            {
+                component->T::Draw(graphics);
+            }
+        }, ref);
+    }
+
+    for (const auto &ref : mOrdered)
+    {
+        std::visit([&graphics](auto component) {
+            using T = std::remove_pointer_t<decltype(component)>;
+            if constexpr (std::is_same_v<T, Component>)
+            {
+                component->DrawForeground(graphics);
+            }
+            else if constexpr (ComponentHooks<T>::DrawForeground)
+            {
+                component->T::DrawForeground(graphics);
+            }
+        }, ref);
+    }
+}
+
+
+/**
+ * Draw the components with the software rasterizer in the
+ * same order as Draw
+ * @param rasterizer Rasterizer to draw into
+ */
+void ComponentGroups::Rasterize(SoftwareRasterizer &rasterizer)
+{
+    for (const auto &ref : mOrdered)
+    {
+        std::visit([&rasterizer](auto component) {
+            using T = std::remove_pointer_t<decltype(component)>;
+            if constexpr (std::is_same_v<T, Component>)
+            {
+                component->Rasterize(rasterizer);
+            }
+            else
+            {
+                component->T::Rasterize(rasterizer);
+            }
+        }, ref);
+    }
+
+    for (const auto &ref : mOrdered)
+    {
+        std::visit([&rasterizer](auto component) {
+            using T = std::remove_pointer_t<decltype(component)>;
+            if constexpr (std::is_same_v<T, Component>)
+            {
+                component->RasterizeForeground(rasterizer);
+            }
+            else if constexpr (ComponentHooks<T>::DrawForeground)
+            {
+                component->T::RasterizeForeground(rasterizer);
+            }
+        }, ref);
+    }
+}
@@ -0,0 +1,111 @@
+/**
+ * @file ComponentGroups.h
+ * @author Shane Carr
+ *
+ * The components of a machine grouped by concrete type.
+ */
+
+#ifndef CANADIANEXPERIENCE_MACHINELIB_COMPONENTGROUPS_H
+#define CANADIANEXPERIENCE_MACHINELIB_COMPONENTGROUPS_H
+
+#include <memory>
+#include <tuple>
+#include <variant>
+#include <vector>
+
+class Component;
+class Box;
+class Sparty;
+class Crank;
+class Shaft;
+class Pulley;
+class Cam;
+class SoftwareRasterizer;
+
+/**
+ * Which hooks of a component type do anything.
+ *
+ * The grouped loops skip the hooks that don't. Keep the
+ * specializations in ComponentGroups.cpp in step with the
+ * components.
+ * @tparam T Component type
+ */
+template <class T>
+struct ComponentHooks
+{
+    /// Does Update do anything?
+    static constexpr bool Update = true;
+
+    /// Do DrawForeground and RasterizeForeground draw anything?
+    static constexpr bool DrawForeground = true;
+};
+
+/**
+ * The components of a machine grouped by concrete type.
+ *
+ * Each known component type has a vector of pointers of its
+ * own. The components themselves stay where the definition owns
+ * them, since rotation sinks and listeners point at them. The
+ * loops over a group call the hooks directly instead of through
+ * the vtable, and leave out the hooks a type doesn't use, see
+ * ComponentHooks.
+ *
+ * Stepping, fast-forwarding and evaluating go group by group,
+ * stateful types first. That gives the same result as going in
+ * the order the components were added, as long as every
+ * stateful component was added before every analytic one. A
+ * stateful component's events come from analytic ones, and the
+ * analytic ones only pass rotation down their own network.
+ * IsGrouped says whether that holds and every component is of
+ * a known type. Drawing is always in the order added, since
+ * that is the order components overlap in.
+ */
+class ComponentGroups
+{
+public:
+    /// A component with its concrete type, Component if not a known one
+    using Ref = std::variant<Box *, Sparty *, Crank *, Shaft *, Pulley *, Cam *, Component *>;
+
+private:
+    /// Components of each known type in the order added,
+    /// the stateful types first
+    std::tuple<std::vector<Box *>, std::vector<Sparty *>,
+            std::vector<Crank *>, std::vector<Shaft *>, std::vector<Pulley *>, std::vector<Cam *>> mGroups;
+
+    /// Every component with its type in the order added
+    std::vector<Ref> mOrdered;
+
+    /// Can the simulation loops go group by group?
+    bool mGrouped = true;
+
+    /// Has an analytic component been added yet?
+    bool mAnalytic = false;
+
+public:
+    /// Default constructor
+    ComponentGroups() = default;
+
+    /// Copy constructor (disabled)
+    ComponentGroups(const ComponentGroups &) = delete;
+
+    /// Assignment operator (disabled)
+    void operator=(const ComponentGroups &) = delete;
+
+    void Add(Component *component);
+
+    /**
+     * Can the simulation loops go group by group?
+     * @return true if they give the same result as the
+     * components in the order added
+     */
+    bool IsGrouped() const { return mGrouped; }
+
+    void Step(double delta, double time, bool evaluate);
+    void FastForward(int frames, double delta, double time);
+    void Evaluate(double time);
+    void Update(double elapsed);
+    void Draw(std::shared_ptr<wxGraphicsContext> graphics);
+    void Rasterize(SoftwareRasterizer &rasterizer);
+};
+
+#endif //CANADIANEXPERIENCE_MACHINELIB_COMPONENTGROUPS_H
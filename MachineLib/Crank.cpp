@@ -0,0 +1,170 @@
+/**
+ * @file Crank.cpp
+ * @author Shane Carr
+ */
+
+#include "pch.h"
+#include "Crank.h"
+#include "SoftwareRasterizer.h"
+
+/// Length of the crank arm in pixels
+const double CrankArmLength = 50;
+
+/// Width of the crank arm in pixels
+const double CrankArmWidth = 10;
+
+/// The color to draw the crank. Colours share reference counted
+/// data when copied, so each thread gets its own.
+thread_local const wxColour CrankColor = wxColour(86, 89, 92);
+
+/// Length of the handle in pixels
+const int CrankHandleLength = 30;
+
+/// Diameter of the handle in pixels
+const int CrankHandleDiameter = 8;
+
+/// Diameter of the hub in pixels
+const int CrankHubDiameter = 16;
+
+/// Length of the hub in pixels
+const int CrankHubLength = 10;
+
+/**
+ * Constructor
+ */
+Crank::Crank()
+{
+    InitState<CrankState>();
+
+    mArm.Rectangle(-CrankArmWidth / 2, 0, CrankArmWidth, CrankArmLength);
+    mArm.SetColor(CrankColor);
+
+    mHandle.SetColour(CrankColor);
+    mHandle.SetSize(CrankHandleDiameter, CrankHandleLength);
+    mHandle.SetLines(wxColour(0, 0, 0), 1, 4);
+
+    mHub.SetColour(CrankColor);
+    mHub.SetSize(CrankHubDiameter, CrankHubLength);
+    mHub.SetLines(wxColour(0, 0, 0), 1, 6);
+}
+
+
+/**
+ * Draw the crank
+ *
+ * We see the crank from the side, so the arm appears to
+ * shorten and lengthen as it turns.
+ * @param graphics Graphics context to draw on
+ */
+void Crank::Draw(std::shared_ptr<wxGraphicsContext> graphics)
+{
+    double rotation = GetRotation();
+    double c = cos(rotation * M_PI * 2);
+
+    graphics->PushState();
+    graphics->Translate(GetX(), GetY());
+
+    graphics->PushState();
+    graphics->Scale(1, c);
+    mArm.DrawPolygon(graphics, 0, 0);
+    graphics->PopState();
+
+    mHub.Draw(graphics, -CrankHubLength, 0, rotation);
+    mHandle.Draw(graphics, 0, -c * CrankArmLength, rotation);
+
+    graphics->PopState();
+}
+
+
+/**
+ * Draw the crank with the software rasterizer
+ * @param rasterizer Rasterizer to draw into
+ */
+void Crank::Rasterize(SoftwareRasterizer &rasterizer)
+{
+    double rotation = GetRotation();
+    double c = cos(rotation * M_PI * 2);
+
+    rasterizer.PushState();
+    rasterizer.Translate(GetX(), GetY());
+
+    rasterizer.PushState();
+    rasterizer.Scale(1, c);
+    mArm.Rasterize(rasterizer, 0, 0);
+    rasterizer.PopState();
+
+    mHub.Rasterize(rasterizer, -CrankHubLength, 0, rotation);
+    mHandle.Rasterize(rasterizer, 0, -c * CrankArmLength, rotation);
+
+    rasterizer.PopState();
+}
+
+
+/**
+ * Turn the crank
+ * @param delta Amount of time to advance in seconds
+ */
+void Crank::Advance(double delta)
+{
+    Component::Advance(delta);
+
+    auto &state = GetState<CrankState>();
+    state.rotation += mSpeed * delta;
+    mSource.SetRotation(state.rotation);
+}
+
+
+/**
+ * Turn the crank to where it is at a machine time.
+ *
+ * Our rotation passes on to the components we drive.
+ * @param time Machine time in seconds
+ */
+void Crank::Evaluate(double time)
+{
+    Component::Evaluate(time);
+
+    auto &state = GetState<CrankState>();
+    state.rotation = mSpeed * time;
+    mSource.SetRotation(state.rotation);
+}
+
+
+/**
+ * Predict when the sinks we drive reach their trigger rotations.
+ *
+ * Only possible once our rotation network is compiled, since
+ * that is where the ratio to each sink comes from.
+ * @param events Collection to add predicted events to
+ */
+void Crank::PredictEvents(std::vector<MachineEvent> &events)
+{
+    if (!mSource.IsCompiled() || mSpeed <= 0)
+    {
+        return;
+    }
+
+    for (const auto &[sink, ratio] : mSource.GetPlan())
+    {
+        auto trigger = sink->GetTriggerRotation();
+        if (trigger.has_value() && ratio > 0)
+        {
+            MachineEvent event;
+            event.time = *trigger / ratio / mSpeed;
+            events.push_back(event);
+        }
+    }
+}
+
+
+/**
+ * Reset the crank to its starting position
+ */
+void Crank::Reset()
+{
+    Component::Reset();
+
+    GetState<CrankState>().rotation = 0;
+    mSource.SetRotation(0);
+}
+
@@ -0,0 +1,125 @@
+/**
+ * @file Crank.h
+ * @author Shane Carr
+ *
+ * The hand crank that drives the machine.
+ */
+
+#ifndef CANADIANEXPERIENCE_MACHINELIB_CRANK_H
+#define CANADIANEXPERIENCE_MACHINELIB_CRANK_H
+
+#include "Component.h"
+#include "Cylinder.h"
+#include "Polygon.h"
+#include "RotationSource.h"
+
+/**
+ * The hand crank that drives the machine.
+ *
+ * The crank turns at a constant speed as the machine runs
+ * and passes its rotation to whatever is connected to its
+ * rotation source.
+ */
+class Crank : public Component
+{
+private:
+    /// Simulation state of the crank
+    struct CrankState : ComponentState
+    {
+        /// Current rotation in turns
+        double rotation = 0;
+    };
+
+    /// Speed in turns per second
+    double mSpeed = 1.0;
+
+    /// Source that passes our rotation on
+    RotationSource mSource;
+
+    /// The crank arm
+    cse335::Polygon mArm;
+
+    /// The handle at the end of the arm
+    cse335::Cylinder mHandle;
+
+    /// The hub the arm turns on
+    cse335::Cylinder mHub;
+
+public:
+    Crank();
+
+    /// Copy constructor (disabled)
+    Crank(const Crank &) = delete;
+
+    /// Assignment operator (disabled)
+    void operator=(const Crank &) = delete;
+
+    void Draw(std::shared_ptr<wxGraphicsContext> graphics) override;
+
+    /**
+     * Draw the foreground elements of the crank (there are none)
+     * @param graphics Graphics context to draw on
+     */
+    void DrawForeground(std::shared_ptr<wxGraphicsContext> graphics) override {}
+
+    void Rasterize(SoftwareRasterizer &rasterizer) override;
+
+    /**
+     * Draw the foreground elements of the crank with the
+     * software rasterizer (there are none)
+     * @param rasterizer Rasterizer to draw into
+     */
+    void RasterizeForeground(SoftwareRasterizer &rasterizer) override {}
+
+    /**
+     * Update the crank (nothing to do, the crank turns in Advance)
+     * @param elapsed Time since the last update in seconds
+     */
+    void Update(double elapsed) override {}
+
+    void Advance(double delta) override;
+    void Reset() override;
+
+    /**
+     * The crank turns at a constant speed
+     * @return true
+     */
+    bool IsAnalytic() const override { return true; }
+
+    void Evaluate(double time) override;
+
+    /**
+     * The crank drives the machine
+     * @return Our rotation source
+     */
+    RotationSource *GetRotationDriver() override { return &mSource; }
+
+    void PredictEvents(std::vector<MachineEvent> &events) override;
+
+
+    /**
+     * Get the source of rotation for the crank
+     * @return Pointer to the rotation source
+     */
+    RotationSource *GetSource() { return &mSource; }
+
+    /**
+     * Set the crank speed
+     * @param speed Speed in turns per second
+     */
+    void SetSpeed(double speed) { mSpeed = speed; }
+
+    /**
+     * Get the crank speed
+     * @return Speed in turns per second
+     */
+    double GetSpeed() const { return mSpeed; }
+
+    /**
+     * Get the current rotation
+     * @return Rotation in turns
+     */
+    double GetRotation() const { return GetState<CrankState>().rotation; }
+};
+
+#endif //CANADIANEXPERIENCE_MACHINELIB_CRANK_H
@@ -5,6 +5,8 @@
 
 #include "pch.h"
 #include "Cylinder.h"
+#include "LevelOfDetail.h"
+#include "SoftwareRasterizer.h"
 
 namespace cse335
 {
@@ -32,7 +34,8 @@ void Cylinder::Draw(const std::shared_ptr<wxGraphicsContext> &graphics, double x
     }
     else
     {
-        graphics->SetPen(*wxTRANSPARENT_PEN);
+        wxPen noPen(mBorderColor, 1, wxPENSTYLE_TRANSPARENT);
+        graphics->SetPen(noPen);
     }
 
     // Draw the rod
@@ -41,14 +44,17 @@ void Cylinder::Draw(const std::shared_ptr<wxGraphicsContext> &graphics, double x
     // The current cylinder rotation angle including the offset in radians
     double angle = (rotation + mOffset) * M_PI * 2.0;    // In radians
 
-    if(mNumLines > 0)
+    // Fewer lines when the cylinder is small on screen
+    int numLines = LevelOfDetail::Get().CylinderLines(mNumLines, mDiameter, LevelOfDetail::Scale(graphics));
+
+    if(numLines > 0)
     {
         // The lines we'll draw
         wxPen linePen(mLineColor, mLineWidth);
         linePen.SetCap(wxCAP_BUTT);
         graphics->SetPen(linePen);
 
-        for(int i = 0; i < mNumLines; i++)
+        for(int i = 0; i < numLines; i++)
         {
             double s = sin(angle);
             double c = cos(angle);
@@ -59,11 +65,53 @@ void Cylinder::Draw(const std::shared_ptr<wxGraphicsContext> &graphics, double x
                 graphics->StrokeLine(x + 1, y2, x + mLength, y2);
             }
 
-            angle += M_PI * 2 / mNumLines;
+            angle += M_PI * 2 / numLines;
         }
 
     }
 
 }
 
+
+/**
+ * Draw the cylinder with the software rasterizer, the same
+ * way Draw does
+ *
+ * @param rasterizer Rasterizer to draw into
+ * @param x X location of left center end of cylinder
+ * @param y Y location of left center end of cylinder
+ * @param rotation Current rotation angle in turns
+ */
+void Cylinder::Rasterize(SoftwareRasterizer &rasterizer, double x, double y, double rotation)
+{
+    // Draw the rod
+    double top = y - mDiameter / 2.0;
+    rasterizer.FillPolygon({wxPoint2DDouble(x, top), wxPoint2DDouble(x + mLength, top),
+                            wxPoint2DDouble(x + mLength, top + mDiameter), wxPoint2DDouble(x, top + mDiameter)}, mColor);
+    if(mBorderColor != wxTRANSPARENT)
+    {
+        rasterizer.StrokeRectangle(x, top, mLength, mDiameter, 1, mBorderColor);
+    }
+
+    // The current cylinder rotation angle including the offset in radians
+    double angle = (rotation + mOffset) * M_PI * 2.0;    // In radians
+
+    // Fewer lines when the cylinder is small on screen
+    int numLines = LevelOfDetail::Get().CylinderLines(mNumLines, mDiameter, LevelOfDetail::Scale(rasterizer));
+
+    for(int i = 0; i < numLines; i++)
+    {
+        double s = sin(angle);
+        double c = cos(angle);
+
+        if(c > 0)       // Test if on the visible side
+        {
+            double y2 = y - s * (mDiameter - mLineWidth) / 2;
+            rasterizer.StrokeLine(x + 1, y2, x + mLength, y2, mLineWidth, mLineColor);
+        }
+
+        angle += M_PI * 2 / numLines;
+    }
+}
+
 }
@@ -11,6 +11,8 @@
 #ifndef _CYLINDER_H
 #define _CYLINDER_H
 
+class SoftwareRasterizer;
+
 namespace cse335
 {
 
@@ -28,13 +30,13 @@ private:
     int mLength = 0;
 
     /// The color to draw the cylinder
-    wxColour mColor = *wxWHITE;
+    wxColour mColor = wxColour(255, 255, 255);
 
     /// The color to draw the border around the cylinder
-    wxColour mBorderColor = *wxBLACK;
+    wxColour mBorderColor = wxColour(0, 0, 0);
 
     /// The color to draw the moving lines on the cylinder
-    wxColour mLineColor = *wxBLACK;
+    wxColour mLineColor = wxColour(0, 0, 0);
 
     /// The width to draw the moving lines
     int mLineWidth = 1;
@@ -105,6 +107,7 @@ public:
     void SetOffset(double offset) {mOffset = offset;}
 
     void Draw(const std::shared_ptr<wxGraphicsContext> &graphics, double x, double y, double rotation);
+    void Rasterize(SoftwareRasterizer &rasterizer, double x, double y, double rotation);
 };
 
 }
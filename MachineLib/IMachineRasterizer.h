@@ -0,0 +1,35 @@
+/**
+ * @file IMachineRasterizer.h
+ * @author Shane Carr
+ *
+ * Interface for machine systems that can draw with the
+ * software rasterizer.
+ */
+
+#ifndef CANADIANEXPERIENCE_MACHINELIB_IMACHINERASTERIZER_H
+#define CANADIANEXPERIENCE_MACHINELIB_IMACHINERASTERIZER_H
+
+class SoftwareRasterizer;
+
+/**
+ * Interface for machine systems that can draw with the
+ * software rasterizer.
+ *
+ * IMachineSystem is fixed, so this is a separate interface.
+ * A machine system that implements both can be found with a
+ * dynamic_cast from the IMachineSystem pointer.
+ */
+class IMachineRasterizer {
+public:
+    /// Destructor
+    virtual ~IMachineRasterizer() = default;
+
+    /**
+     * Draw the machine at its location with the software
+     * rasterizer, like IMachineSystem::DrawMachine
+     * @param rasterizer Rasterizer to draw into
+     */
+    virtual void RasterizeMachine(SoftwareRasterizer &rasterizer) = 0;
+};
+
+#endif //CANADIANEXPERIENCE_MACHINELIB_IMACHINERASTERIZER_H
@@ -0,0 +1,31 @@
+/**
+ * @file IMachineSeek.h
+ * @author Shane Carr
+ *
+ * Interface for machine systems that can say what a seek costs.
+ */
+
+#ifndef CANADIANEXPERIENCE_MACHINELIB_IMACHINESEEK_H
+#define CANADIANEXPERIENCE_MACHINELIB_IMACHINESEEK_H
+
+/**
+ * Interface for machine systems that can say what a seek costs.
+ *
+ * IMachineSystem is fixed, so this is a separate interface,
+ * found with a dynamic_cast like IMachineRasterizer.
+ */
+class IMachineSeek {
+public:
+    /// Destructor
+    virtual ~IMachineSeek() = default;
+
+    /**
+     * How many frames SetMachineFrame would step to get to a
+     * frame from the current one
+     * @param frame Machine frame to seek to
+     * @return Frame count
+     */
+    virtual int GetSeekFrames(int frame) const = 0;
+};
+
+#endif //CANADIANEXPERIENCE_MACHINELIB_IMACHINESEEK_H
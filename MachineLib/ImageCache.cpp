@@ -0,0 +1,219 @@
+/**
+ * @file ImageCache.cpp
+ * @author Shane Carr
+ */
+
+#include "pch.h"
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <vector>
+#include <wx/mstream.h>
+
+#include "ImageCache.h"
+
+/// FNV-1a 64 bit offset basis
+const uint64_t FnvOffset = 14695981039346656037ull;
+
+/// FNV-1a 64 bit prime
+const uint64_t FnvPrime = 1099511628211ull;
+
+/**
+ * Number of bytes a decoded image occupies
+ * @param image Image to measure
+ * @return Size in bytes
+ */
+static size_t ImageBytes(const wxImage &image)
+{
+    size_t pixels = size_t(image.GetWidth()) * image.GetHeight();
+    return pixels * (image.HasAlpha() ? 4 : 3);
+}
+
+
+/**
+ * Get the process-wide image cache.
+ *
+ * The cache is deliberately never deleted. Bitmaps still in it
+ * at static destruction would outlive their renderer.
+ * @return The cache
+ */
+ImageCache &ImageCache::Get()
+{
+    static auto cache = new ImageCache();
+    return *cache;
+}
+
+
+/**
+ * Load an image, sharing it with anyone else that loaded
+ * the same file.
+ *
+ * If the file can't be loaded the image returned is not ok
+ * and is not cached.
+ * @param filename File to load
+ * @return Shared, immutable image. Never null.
+ */
+std::shared_ptr<const wxImage> ImageCache::Load(const std::wstring &filename)
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        auto found = mPaths.find(filename);
+        if (found != mPaths.end())
+        {
+            if (auto image = found->second.lock())
+            {
+                mHits++;
+                mBytesSaved += ImageBytes(*image);
+                return image;
+            }
+        }
+    }
+
+    // Read the file ourselves so we can hash the contents
+    std::ifstream file(std::filesystem::path(filename), std::ios::binary);
+    std::vector<char> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    uint64_t hash = FnvOffset;
+    for (auto byte : bytes)
+    {
+        hash = (hash ^ uint64_t((unsigned char)byte)) * FnvPrime;
+    }
+    ContentKey key(hash, bytes.size());
+
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        auto found = mContents.find(key);
+        if (found != mContents.end() && !bytes.empty())
+        {
+            if (auto image = found->second.lock())
+            {
+                mHits++;
+                mBytesSaved += ImageBytes(*image);
+                mPaths[filename] = image;
+                return image;
+            }
+        }
+    }
+
+    // Decode outside the lock, decoding is the slow part
+    auto image = std::make_shared<wxImage>();
+    if (!bytes.empty())
+    {
+        wxLogNull logNo;
+        wxMemoryInputStream stream(bytes.data(), bytes.size());
+        image->LoadFile(stream, wxBITMAP_TYPE_ANY);
+    }
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    mMisses++;
+    if (!image->IsOk())
+    {
+        return image;
+    }
+
+    // Another thread may have decoded the same file meanwhile
+    auto &entry = mContents[key];
+    if (auto other = entry.lock())
+    {
+        mPaths[filename] = other;
+        return other;
+    }
+
+    entry = image;
+    mPaths[filename] = image;
+    Purge();
+    return image;
+}
+
+
+/**
+ * Get a graphics bitmap for a cached image.
+ *
+ * Bitmaps belong to a renderer, so one is kept for each
+ * renderer and thread the image is drawn with.
+ * @param graphics Graphics context we will draw with
+ * @param image Image from Load
+ * @return Graphics bitmap for the image
+ */
+wxGraphicsBitmap ImageCache::GetBitmap(std::shared_ptr<wxGraphicsContext> graphics,
+        const std::shared_ptr<const wxImage> &image)
+{
+    auto renderer = graphics->GetRenderer();
+    auto thread = std::this_thread::get_id();
+
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        auto range = mBitmaps.equal_range(image.get());
+        for (auto i = range.first; i != range.second; ++i)
+        {
+            if (i->second.renderer == renderer && i->second.thread == thread &&
+                i->second.image.lock() == image)
+            {
+                mBitmapHits++;
+                return i->second.bitmap;
+            }
+        }
+    }
+
+    // Create the bitmap outside the lock so other threads are not
+    // held up. Entries are per thread, so no other thread can be
+    // creating this one.
+    BitmapEntry entry;
+    entry.image = image;
+    entry.renderer = renderer;
+    entry.thread = thread;
+    entry.bitmap = graphics->CreateBitmapFromImage(*image);
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    Purge();
+    mBitmaps.emplace(image.get(), entry);
+    return entry.bitmap;
+}
+
+
+/**
+ * Release every graphics bitmap in the cache.
+ *
+ * Call this before the graphics renderers shut down, when
+ * the application exits. Images stay cached as long as
+ * they are in use.
+ */
+void ImageCache::Clear()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    mBitmaps.clear();
+    Purge();
+}
+
+
+/**
+ * Drop entries for images nobody is using anymore.
+ *
+ * Must be called with the mutex held.
+ */
+void ImageCache::Purge()
+{
+    std::erase_if(mPaths, [](const auto &item) { return item.second.expired(); });
+    std::erase_if(mContents, [](const auto &item) { return item.second.expired(); });
+    std::erase_if(mBitmaps, [](const auto &item) { return item.second.image.expired(); });
+}
+
+
+/**
+ * Number of images currently alive in the cache
+ * @return Image count
+ */
+size_t ImageCache::GetImageCount() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    size_t count = 0;
+    for (const auto &item : mContents)
+    {
+        if (!item.second.expired())
+        {
+            count++;
+        }
+    }
+
+    return count;
+}
@@ -0,0 +1,127 @@
+/**
+ * @file ImageCache.h
+ * @author Shane Carr
+ *
+ * Process-wide cache of decoded images and their graphics bitmaps.
+ */
+
+#ifndef CANADIANEXPERIENCE_MACHINELIB_IMAGECACHE_H
+#define CANADIANEXPERIENCE_MACHINELIB_IMAGECACHE_H
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+/**
+ * Process-wide cache of decoded images and their graphics bitmaps.
+ *
+ * Images are looked up first by path, then by a hash of the
+ * file contents, so the same file loaded through different paths
+ * is only decoded once. The cache only holds weak references.
+ * An image and its bitmaps are evicted when the last user lets
+ * go of the image.
+ *
+ * Images handed out are shared and must not be modified.
+ *
+ * Graphics bitmaps must be released while their renderer is
+ * still alive, so applications call Clear when they exit. The
+ * cache itself is never destroyed, so bitmaps left in it are
+ * not released during static destruction.
+ */
+class ImageCache {
+private:
+    /// Key for the content map: hash and size of the file
+    using ContentKey = std::pair<uint64_t, size_t>;
+
+    /// A graphics bitmap created from a cached image
+    struct BitmapEntry
+    {
+        /// The image the bitmap was created from
+        std::weak_ptr<const wxImage> image;
+
+        /// The renderer the bitmap belongs to
+        wxGraphicsRenderer *renderer = nullptr;
+
+        /// The thread the bitmap was created on. Bitmaps are
+        /// not shared between threads that render at once.
+        std::thread::id thread;
+
+        /// The bitmap
+        wxGraphicsBitmap bitmap;
+    };
+
+    /// Images by path
+    std::map<std::wstring, std::weak_ptr<const wxImage>> mPaths;
+
+    /// Images by content
+    std::map<ContentKey, std::weak_ptr<const wxImage>> mContents;
+
+    /// Bitmaps by image
+    std::multimap<const wxImage *, BitmapEntry> mBitmaps;
+
+    /// Protects the maps and statistics
+    mutable std::mutex mMutex;
+
+    /// Number of loads satisfied from the cache
+    int mHits = 0;
+
+    /// Number of loads that had to decode
+    int mMisses = 0;
+
+    /// Number of bitmap requests satisfied from the cache
+    int mBitmapHits = 0;
+
+    /// Decoded bytes we did not have to allocate again
+    size_t mBytesSaved = 0;
+
+    void Purge();
+
+    ImageCache() {}
+
+public:
+    /// Copy constructor (disabled)
+    ImageCache(const ImageCache &) = delete;
+
+    /// Assignment operator (disabled)
+    void operator=(const ImageCache &) = delete;
+
+    static ImageCache &Get();
+
+    std::shared_ptr<const wxImage> Load(const std::wstring &filename);
+
+    wxGraphicsBitmap GetBitmap(std::shared_ptr<wxGraphicsContext> graphics,
+            const std::shared_ptr<const wxImage> &image);
+
+    void Clear();
+
+    size_t GetImageCount() const;
+
+    /**
+     * Number of loads satisfied from the cache
+     * @return Hit count
+     */
+    int GetHits() const { std::lock_guard<std::mutex> lock(mMutex); return mHits; }
+
+    /**
+     * Number of loads that had to decode a file
+     * @return Miss count
+     */
+    int GetMisses() const { std::lock_guard<std::mutex> lock(mMutex); return mMisses; }
+
+    /**
+     * Number of bitmap requests satisfied from the cache
+     * @return Bitmap hit count
+     */
+    int GetBitmapHits() const { std::lock_guard<std::mutex> lock(mMutex); return mBitmapHits; }
+
+    /**
+     * Decoded image bytes that did not have to be allocated again
+     * @return Bytes saved
+     */
+    size_t GetBytesSaved() const { std::lock_guard<std::mutex> lock(mMutex); return mBytesSaved; }
+};
+
+#endif //CANADIANEXPERIENCE_MACHINELIB_IMAGECACHE_H
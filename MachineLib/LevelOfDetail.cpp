@@ -0,0 +1,122 @@
+/**
+ * @file LevelOfDetail.cpp
+ * @author Shane Carr
+ */
+
+#include "pch.h"
+#include <algorithm>
+#include <cmath>
+
+#include "LevelOfDetail.h"
+#include "SoftwareRasterizer.h"
+
+/**
+ * Get the process-wide level of detail settings
+ * @return The settings
+ */
+LevelOfDetail &LevelOfDetail::Get()
+{
+    static LevelOfDetail lod;
+    return lod;
+}
+
+
+/**
+ * Get the scale of the current graphics transform.
+ *
+ * This is how many pixels one unit becomes, averaged over
+ * both axes so rotation and flips do not matter.
+ * @param graphics Graphics context we are drawing on
+ * @return Pixels per unit
+ */
+double LevelOfDetail::Scale(const std::shared_ptr<wxGraphicsContext> &graphics)
+{
+    wxDouble a, b, c, d, tx, ty;
+    graphics->GetTransform().Get(&a, &b, &c, &d, &tx, &ty);
+    return sqrt(fabs(a * d - b * c));
+}
+
+
+/**
+ * Get the scale of the current rasterizer transform
+ * @param rasterizer Rasterizer we are drawing into
+ * @return Pixels per unit
+ */
+double LevelOfDetail::Scale(const SoftwareRasterizer &rasterizer)
+{
+    const auto &m = rasterizer.GetTransform();
+    return sqrt(fabs(m.a * m.d - m.b * m.c));
+}
+
+
+/**
+ * How many lines to draw on a cylinder
+ * @param lines Lines the cylinder asked for
+ * @param diameter Cylinder diameter in units
+ * @param scale Pixels per unit
+ * @return Lines to draw
+ */
+int LevelOfDetail::CylinderLines(int lines, double diameter, double scale) const
+{
+    if (!mEnabled || lines <= 0)
+    {
+        return lines;
+    }
+
+    double pixels = diameter * scale;
+    if (pixels < mCylinderMinPixels)
+    {
+        return 0;
+    }
+
+    // Half the lines are on the visible side, spread over the diameter
+    int fit = int(2 * pixels / mCylinderLineSpacing);
+    return std::clamp(fit, 1, lines);
+}
+
+
+/**
+ * How many links to draw in a spring
+ * @param links Links the spring asked for
+ * @param length Spring length in units
+ * @param scale Pixels per unit
+ * @return Links to draw
+ */
+int LevelOfDetail::SpringLinks(int links, double length, double scale) const
+{
+    if (!mEnabled || links <= 1)
+    {
+        return links;
+    }
+
+    int fit = int(length * scale / mSpringLinkPixels);
+    return std::clamp(fit, 1, links);
+}
+
+
+/**
+ * How many segments to draw a circle with.
+ *
+ * Uses the fewest segments that keep the chord within the
+ * tolerance of the true circle.
+ * @param steps Segments the circle was built with
+ * @param radius Circle radius in units
+ * @param scale Pixels per unit
+ * @return Segments to draw
+ */
+int LevelOfDetail::CircleSteps(int steps, double radius, double scale) const
+{
+    if (!mEnabled || steps <= mCircleMinSteps)
+    {
+        return steps;
+    }
+
+    double pixels = radius * scale;
+    if (pixels <= mCircleTolerance)
+    {
+        return mCircleMinSteps;
+    }
+
+    int needed = int(ceil(M_PI / acos(1 - mCircleTolerance / pixels)));
+    return std::clamp(needed, mCircleMinSteps, steps);
+}
@@ -0,0 +1,107 @@
+/**
+ * @file LevelOfDetail.h
+ * @author Shane Carr
+ *
+ * Reduces procedural detail that would be too small to see.
+ */
+
+#ifndef CANADIANEXPERIENCE_MACHINELIB_LEVELOFDETAIL_H
+#define CANADIANEXPERIENCE_MACHINELIB_LEVELOFDETAIL_H
+
+#include <memory>
+
+class SoftwareRasterizer;
+
+/**
+ * Reduces procedural detail that would be too small to see.
+ *
+ * Cylinder lines, spring links and circle segments are
+ * generated in machine units. How big they end up on the
+ * screen depends on the current graphics transform. These
+ * functions take the full detail a component asked for and
+ * return how much of it is worth drawing at the current
+ * scale, based on pixel thresholds that can be changed.
+ *
+ * There is one set of thresholds for the process. Set them
+ * before drawing starts.
+ */
+class LevelOfDetail {
+private:
+    /// Is level of detail reduction enabled?
+    bool mEnabled = true;
+
+    /// Cylinders smaller than this many pixels across get no lines
+    double mCylinderMinPixels = 6;
+
+    /// Smallest spacing in pixels between cylinder lines
+    double mCylinderLineSpacing = 3;
+
+    /// Smallest length in pixels of a spring link
+    double mSpringLinkPixels = 4;
+
+    /// Largest distance in pixels a circle segment may stray from the true circle
+    double mCircleTolerance = 0.25;
+
+    /// Fewest segments a circle is ever drawn with
+    int mCircleMinSteps = 8;
+
+    LevelOfDetail() {}
+
+public:
+    static LevelOfDetail &Get();
+
+    /// Copy constructor (disabled)
+    LevelOfDetail(const LevelOfDetail &) = delete;
+
+    /// Assignment operator (disabled)
+    void operator=(const LevelOfDetail &) = delete;
+
+    static double Scale(const std::shared_ptr<wxGraphicsContext> &graphics);
+    static double Scale(const SoftwareRasterizer &rasterizer);
+
+    int CylinderLines(int lines, double diameter, double scale) const;
+    int SpringLinks(int links, double length, double scale) const;
+    int CircleSteps(int steps, double radius, double scale) const;
+
+    /**
+     * Is level of detail reduction enabled?
+     * @return true if enabled
+     */
+    bool IsEnabled() const { return mEnabled; }
+
+    /**
+     * Enable or disable level of detail reduction
+     * @param enabled false to always draw full detail
+     */
+    void SetEnabled(bool enabled) { mEnabled = enabled; }
+
+    /**
+     * Set the cylinder line thresholds
+     * @param minPixels Cylinders smaller than this many pixels across get no lines
+     * @param spacing Smallest spacing in pixels between lines
+     */
+    void SetCylinderThresholds(double minPixels, double spacing)
+    {
+        mCylinderMinPixels = minPixels;
+        mCylinderLineSpacing = spacing;
+    }
+
+    /**
+     * Set the spring link threshold
+     * @param pixels Smallest length in pixels of a spring link
+     */
+    void SetSpringThreshold(double pixels) { mSpringLinkPixels = pixels; }
+
+    /**
+     * Set the circle thresholds
+     * @param tolerance Largest distance in pixels a segment may stray from the circle
+     * @param minSteps Fewest segments a circle is drawn with
+     */
+    void SetCircleThresholds(double tolerance, int minSteps)
+    {
+        mCircleTolerance = tolerance;
+        mCircleMinSteps = minSteps;
+    }
+};
+
+#endif //CANADIANEXPERIENCE_MACHINELIB_LEVELOFDETAIL_H
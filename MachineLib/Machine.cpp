@@ -0,0 +1,212 @@
+/**
+ * @file Machine.cpp
+ * @author Shane Carr
+ */
+
+#include "pch.h"
+#include "Machine.h"
+
+/**
+ * Constructor
+ * @param definition Components to build the machine from
+ */
+Machine::Machine(std::shared_ptr<MachineDefinition> definition) :
+    mDefinition(definition), mState(definition->CreateState()), mTimeOffset(definition->GetTimeOffset())
+{
+    ScheduleEvents();
+}
+
+void Machine::Draw(std::shared_ptr<wxGraphicsContext> graphics)
+{
+    auto binding = Bind();
+    if (mGrouped)
+    {
+        mDefinition->GetGroups().Draw(graphics);
+        return;
+    }
+
+    for (auto component : GetComponents())
+    {
+        component->Draw(graphics);
+    }
+
+    // Foregrounds go in front of every component
+    for (auto component : GetComponents())
+    {
+        component->DrawForeground(graphics);
+    }
+}
+
+void Machine::Rasterize(SoftwareRasterizer &rasterizer)
+{
+    auto binding = Bind();
+    if (mGrouped)
+    {
+        mDefinition->GetGroups().Rasterize(rasterizer);
+        return;
+    }
+
+    for (auto component : GetComponents())
+    {
+        component->Rasterize(rasterizer);
+    }
+
+    // Foregrounds go in front of every component
+    for (auto component : GetComponents())
+    {
+        component->RasterizeForeground(rasterizer);
+    }
+}
+
+void Machine::Update(double elapsedTime)
+{
+    auto binding = Bind();
+    auto &groups = mDefinition->GetGroups();
+    if (mGrouped && groups.IsGrouped())
+    {
+        groups.Update(elapsedTime);
+        return;
+    }
+
+    for (auto component : GetComponents())
+    {
+        component->Update(elapsedTime);
+    }
+}
+
+void Machine::Reset()
+{
+    auto binding = Bind();
+    SetTime(0);
+    for (auto component : GetComponents())
+    {
+        component->Reset();
+    }
+
+    ScheduleEvents();
+}
+
+void Machine::Advance(double delta)
+{
+    auto binding = Bind();
+    for (auto component : GetComponents())
+    {
+        component->Advance(delta);
+    }
+}
+
+void Machine::Step(double delta, double time)
+{
+    auto binding = Bind();
+
+    // Start evaluating a frame early, so rounding in the
+    // prediction can't make us miss the frame of the event
+    bool evaluate = mPolling || (!mEvents.empty() && time + delta >= mEvents.top().time);
+
+    auto &groups = mDefinition->GetGroups();
+    if (mGrouped && groups.IsGrouped())
+    {
+        groups.Step(delta, time, evaluate);
+    }
+    else
+    {
+        // Same order as Advance, so events reach the stateful
+        // components on the same frame they would by stepping
+        for (auto component : GetComponents())
+        {
+            if (!component->IsAnalytic())
+            {
+                component->FastForward(1, delta, time);
+            }
+            else if (evaluate)
+            {
+                component->Evaluate(time);
+            }
+        }
+    }
+
+    if (evaluate)
+    {
+        // Events that fired are no longer predicted
+        ScheduleEvents();
+    }
+}
+
+void Machine::FastForward(int frames, double delta, double time)
+{
+    auto binding = Bind();
+    auto &groups = mDefinition->GetGroups();
+    if (mGrouped && groups.IsGrouped())
+    {
+        groups.FastForward(frames, delta, time);
+        return;
+    }
+
+    for (auto component : GetComponents())
+    {
+        if (!component->IsAnalytic())
+        {
+            component->FastForward(frames, delta, time);
+        }
+    }
+}
+
+void Machine::Evaluate(double time)
+{
+    auto binding = Bind();
+    auto &groups = mDefinition->GetGroups();
+    if (mGrouped && groups.IsGrouped())
+    {
+        groups.Evaluate(time);
+    }
+    else
+    {
+        for (auto component : GetComponents())
+        {
+            if (component->IsAnalytic())
+            {
+                component->Evaluate(time);
+            }
+        }
+    }
+
+    if (mPolling || !mEvents.empty())
+    {
+        ScheduleEvents();
+    }
+}
+
+void Machine::ScheduleEvents()
+{
+    auto binding = Bind();
+    std::vector<MachineEvent> events;
+    for (auto component : GetComponents())
+    {
+        component->PredictEvents(events);
+    }
+
+    mEvents = {};
+    for (size_t i = 0; i < events.size(); i++)
+    {
+        events[i].order = int(i);
+        mEvents.push(events[i]);
+    }
+
+    // Anything with events pending that nobody predicted
+    size_t pending = 0;
+    for (auto component : GetComponents())
+    {
+        if (component->HasPendingEvents())
+        {
+            pending++;
+        }
+    }
+
+    mPolling = pending > events.size();
+}
+
+void Machine::RestoreState(const MachineSnapshot &snapshot)
+{
+    mState->Restore(snapshot);
+    ScheduleEvents();
+}
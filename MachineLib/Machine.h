@@ -9,12 +9,26 @@
 #define CANADIANEXPERIENCE_MACHINELIB_MACHINE_H
 
 #include <wx/graphics.h>
+#include <limits>
+#include <queue>
 #include "Component.h"
+#include "MachineDefinition.h"
+#include "MachineState.h"
+
+class SoftwareRasterizer;
+
 /**
  * Class that represents a machine composed of multiple components.
  *
  * The Machine class manages all components, updates their states over time,
  * and handles rendering of the machine as a whole.
+ *
+ * The components come from a MachineDefinition that may be shared
+ * with other machines. The machine owns the state block its
+ * components keep their simulation state in, so saving and
+ * restoring the machine is a copy of that one block. Every
+ * method binds the block while it works on the components. To
+ * read a component's state directly, hold a binding from Bind.
  */
 class Machine
 {
@@ -25,15 +39,29 @@ private:
     /// Unique identifier for this machine
     int mMachineNumber = 0;
 
-    /// List of components that make up the machine
-    std::vector<std::shared_ptr<Component>> mComponents;
+    /// Components, geometry and connections, possibly shared
+    std::shared_ptr<MachineDefinition> mDefinition;
+
+    /// Simulation state of the machine and its components
+    std::shared_ptr<MachineState> mState;
 
-    /// Current time of the machine's animation
-    double mTime = 0;
+    /// Offset of the machine time in the state block
+    size_t mTimeOffset = 0;
+
+    /// Predicted events, earliest first
+    std::priority_queue<MachineEvent, std::vector<MachineEvent>, std::greater<>> mEvents;
+
+    /// Are there events nobody could predict? Then the
+    /// analytic components are evaluated every frame. Also
+    /// set until events have been scheduled.
+    bool mPolling = true;
+
+    /// Go through the components by type group instead of
+    /// calling each one through the vtable?
+    bool mGrouped = true;
 
 public:
-    /// Default constructor
-    Machine();
+    Machine(std::shared_ptr<MachineDefinition> definition);
 
     /// Copy constructor (disabled)
     Machine(const Machine &) = delete;
@@ -41,12 +69,40 @@ public:
     /// Assignment operator (disabled)
     void operator=(const Machine &) = delete;
 
+    /**
+     * Bind our state block for the components on this thread
+     * @return Binding, the block is bound while it exists
+     */
+    MachineState::Binding Bind() const { return MachineState::Binding(mDefinition->GetLayout(), *mState); }
+
+    /**
+     * Set whether the loops over the components go by type
+     * group, see ComponentGroups. Either way gives the same
+     * result. The simulation loops only group if the machine
+     * allows it.
+     * @param grouped true to go by group, false to call each
+     * component through the vtable in the order added
+     */
+    void SetGrouped(bool grouped) { mGrouped = grouped; }
+
+    /**
+     * Do the loops over the components go by type group?
+     * @return true if grouped
+     */
+    bool IsGrouped() const { return mGrouped; }
+
     /**
      * Draw the machine and all its components.
      * @param graphics Graphics context used for rendering the machine.
      */
     void Draw(std::shared_ptr<wxGraphicsContext> graphics);
 
+    /**
+     * Draw the machine and all its components with the software rasterizer.
+     * @param rasterizer Rasterizer to draw into.
+     */
+    void Rasterize(SoftwareRasterizer &rasterizer);
+
     /**
      * Update the state of the machine and its components.
      * @param elapsedTime Time elapsed since the last update, in seconds.
@@ -54,16 +110,16 @@ public:
     void Update(double elapsedTime);
 
     /**
-     * Add a component to the machine.
-     * @param component Shared pointer to the component to be added.
+     * Set the current time of the machine's animation.
+     * @param time New time to set, in seconds.
      */
-    void AddComponent(std::shared_ptr<Component> component);
+    void SetTime(double time) { mState->At<double>(mTimeOffset) = time; }
 
     /**
-     * Set the current time of the machine's animation.
-     * @param time New time to set, in seconds.
+     * Get the current time of the machine's animation.
+     * @return Time in seconds
      */
-    void SetTime(double time) { mTime = time; }
+    double GetTime() const { return mState->At<double>(mTimeOffset); }
 
     /// Reset the machine and all its components to their initial state.
     void Reset();
@@ -73,6 +129,92 @@ public:
      * @param delta Amount of time to advance, in seconds.
      */
     void Advance(double delta);
+
+    /**
+     * Step the machine one frame.
+     *
+     * Stateful components are advanced. Analytic components are
+     * only evaluated on frames where an event is predicted, or
+     * every frame if there are events that can't be predicted.
+     * Call Evaluate when done stepping to bring them up to date.
+     * @param delta Frame time in seconds
+     * @param time Machine time at the end of the frame
+     */
+    void Step(double delta, double time);
+
+    /**
+     * Advance the stateful components a number of frames at once.
+     *
+     * Only valid when no event can happen during those frames,
+     * see GetNextEventTime. Call Evaluate when done to bring the
+     * analytic components up to date.
+     * @param frames Number of frames to advance
+     * @param delta Frame time in seconds
+     * @param time Machine time at the end of the last frame
+     */
+    void FastForward(int frames, double delta, double time);
+
+    /**
+     * Evaluate all of the analytic components at a machine time.
+     * @param time Machine time in seconds
+     */
+    void Evaluate(double time);
+
+    /**
+     * Get the problems found compiling the rotation networks
+     * @return Error messages
+     */
+    const std::vector<std::wstring> &GetRotationErrors() const { return mDefinition->GetRotationErrors(); }
+
+    /**
+     * Predict the upcoming events from the current state.
+     */
+    void ScheduleEvents();
+
+    /**
+     * Get the time of the next predicted event
+     * @return Machine time in seconds, infinity if none
+     */
+    double GetNextEventTime() const
+    {
+        return mEvents.empty() ? std::numeric_limits<double>::infinity() : mEvents.top().time;
+    }
+
+    /**
+     * Are there events that could not be predicted?
+     * @return true if the analytic components are evaluated every frame
+     */
+    bool IsPolling() const { return mPolling; }
+
+    /**
+     * Save the simulation state of the machine and all its components.
+     * @param snapshot Snapshot to fill
+     */
+    void SaveState(MachineSnapshot &snapshot) const { mState->Save(snapshot); }
+
+    /**
+     * Restore state saved by SaveState.
+     * @param snapshot Saved state
+     */
+    void RestoreState(const MachineSnapshot &snapshot);
+
+    /**
+     * Get the state block of the machine
+     * @return State block
+     */
+    const MachineState &GetState() const { return *mState; }
+
+    /**
+     * Get the components that make up the machine
+     * @return Components in the order they were added
+     */
+    const std::vector<std::shared_ptr<Component>> &GetComponents() const { return mDefinition->GetComponents(); }
+
+    /**
+     * Get the definition the machine was built from
+     * @return Definition, shared with other machines of the same kind
+     */
+    std::shared_ptr<MachineDefinition> GetDefinition() const { return mDefinition; }
 };
 
 #endif //CANADIANEXPERIENCE_MACHINELIB_MACHINE_H
@@ -6,7 +6,7 @@
 
 #include "pch.h"
 #include "Machine1Factory.h"
-#include "Machine.h"
+#include "MachineDefinition.h"
 #include "Box.h"
 #include "Sparty.h"
 #include "Crank.h"
@@ -35,10 +35,10 @@ Machine1Factory::Machine1Factory(std::wstring resourcesDir) :
  * Factory method to create machine #1
  * @return
  */
-std::shared_ptr<Machine> Machine1Factory::Create()
+std::shared_ptr<MachineDefinition> Machine1Factory::Create()
 {
     // The machine itself
-    auto machine = std::make_shared<Machine>();
+    auto machine = std::make_shared<MachineDefinition>();
 
     /*
      * The Box class constructor parameters are:
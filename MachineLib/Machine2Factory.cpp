@@ -0,0 +1,99 @@
+/**
+ * @file Machine2Factory.cpp
+ * @author Shane Carr
+ */
+
+#include "pch.h"
+#include "Machine2Factory.h"
+#include "MachineDefinition.h"
+#include "Box.h"
+#include "Sparty.h"
+#include "Crank.h"
+#include "Shaft.h"
+#include "Pulley.h"
+#include "Cam.h"
+
+/// The images directory in resources
+const std::wstring ImagesDirectory = L"/images";
+
+/**
+ * Constructor
+ * @param resourcesDir Path to the resources directory
+ */
+Machine2Factory::Machine2Factory(std::wstring resourcesDir) :
+    mResourcesDir(resourcesDir)
+{
+    mImagesDir = mResourcesDir + ImagesDirectory;
+}
+
+
+/**
+ * Factory method to create machine #2
+ *
+ * Laid out like machine #1, with the other Sparty, a faster
+ * crank and less reduction in the pulleys, so the key falls
+ * sooner.
+ * @return Machine definition
+ */
+std::shared_ptr<MachineDefinition> Machine2Factory::Create()
+{
+    // The machine itself
+    auto machine = std::make_shared<MachineDefinition>();
+
+    auto box = std::make_shared<Box>(mImagesDir, 250, 240);
+    machine->AddComponent(box);
+
+    auto sparty = std::make_shared<Sparty>(mImagesDir + L"/sparty2.png", 212, 260, 80, 15);
+    machine->AddComponent(sparty);
+
+    auto shaft1 = std::make_shared<Shaft>(80);
+    shaft1->SetPosition(80, -175);
+    machine->AddComponent(shaft1);
+
+    auto crank = std::make_shared<Crank>();
+    crank->SetPosition(150, -100);
+    crank->SetSpeed(1.5);
+    machine->AddComponent(crank);
+
+    auto shaft2 = std::make_shared<Shaft>(230);
+    shaft2->SetPosition(-115, -75);
+    machine->AddComponent(shaft2);
+
+    auto shaft3 = std::make_shared<Shaft>(60);
+    shaft3->SetPosition(-115, -175);
+    machine->AddComponent(shaft3);
+
+    auto pulley1 = std::make_shared<Pulley>(20);
+    pulley1->SetPosition(95, -175);
+    machine->AddComponent(pulley1);
+
+    auto pulley2 = std::make_shared<Pulley>(30);
+    pulley2->SetPosition(95, -75);
+    machine->AddComponent(pulley2);
+
+    auto pulley3 = std::make_shared<Pulley>(15);
+    pulley3->SetPosition(-105, -75);
+    machine->AddComponent(pulley3);
+
+    auto pulley4 = std::make_shared<Pulley>(30);
+    pulley4->SetPosition(-105, -175);
+    machine->AddComponent(pulley4);
+
+    auto cam = std::make_shared<Cam>(mImagesDir);
+    cam->SetPosition(-70, -175);
+    machine->AddComponent(cam);
+
+    crank->GetSource()->AddSink(shaft1.get());
+    shaft1->GetSource()->AddSink(pulley1.get());
+    pulley1->BeltTo(pulley2.get());
+    pulley2->GetSource()->AddSink(shaft2.get());
+    shaft2->GetSource()->AddSink(pulley3.get());
+    pulley3->BeltTo(pulley4.get());
+    pulley4->GetSource()->AddSink(shaft3.get());
+    shaft3->GetSource()->AddSink(cam.get());
+
+    cam->AddKeyFallListener(box.get());
+    cam->AddKeyFallListener(sparty.get());
+
+    return machine;
+}
@@ -11,7 +11,7 @@
 #include <memory>
 #include <string>
 
-class Machine;
+class MachineDefinition;
 class Shape;
 
 /**
@@ -28,7 +28,7 @@ private:
 public:
     Machine2Factory(std::wstring resourcesDir);
 
-    std::shared_ptr<Machine> Create();
+    std::shared_ptr<MachineDefinition> Create();
 };
 
 #endif //CANADIANEXPERIENCE_MACHINELIB_MACHINE2FACTORY_H
@@ -6,7 +6,7 @@
 
 #include "pch.h"
 #include "MachineCFactory.h"
-#include "Machine.h"
+#include "MachineDefinition.h"
 #include "Box.h"
 #include "Sparty.h"
 #include "Crank.h"
@@ -35,10 +35,10 @@ MachineCFactory::MachineCFactory(std::wstring resourcesDir) :
  * Factory method to create machine #1
  * @return
  */
-std::shared_ptr<Machine> MachineCFactory::Create()
+std::shared_ptr<MachineDefinition> MachineCFactory::Create()
 {
     // The machine itself
-    auto machine = std::make_shared<Machine>();
+    auto machine = std::make_shared<MachineDefinition>();
 
     /*
      * The Box class constructor parameters are:
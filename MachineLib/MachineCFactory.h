@@ -12,7 +12,7 @@
 #include <memory>
 #include <string>
 
-class Machine;
+class MachineDefinition;
 class Shape;
 
 /**
@@ -29,7 +29,7 @@ private:
 public:
     MachineCFactory(std::wstring resourcesDir);
 
-    std::shared_ptr<Machine> Create();
+    std::shared_ptr<MachineDefinition> Create();
 };
 
 #endif //CANADIANEXPERIENCE_MACHINECFACTORY_H
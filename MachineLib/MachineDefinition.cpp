@@ -0,0 +1,74 @@
+/**
+ * @file MachineDefinition.cpp
+ * @author Shane Carr
+ */
+
+#include "pch.h"
+#include "MachineDefinition.h"
+#include "RotationSource.h"
+
+/**
+ * Constructor
+ */
+MachineDefinition::MachineDefinition() : mState(std::make_shared<MachineState>())
+{
+    mTimeOffset = mState->Create<double>();
+}
+
+
+/**
+ * Add a component, moving its state into our block
+ * @param component Component to add
+ */
+void MachineDefinition::AddComponent(std::shared_ptr<Component> component)
+{
+    mComponents.push_back(component);
+    mGroups.Add(component.get());
+    component->MoveState(mState);
+}
+
+
+/**
+ * Compile the rotation networks once the machine is built.
+ *
+ * Problems are logged and kept in GetRotationErrors.
+ * @return true if every network compiled
+ */
+bool MachineDefinition::CompileRotation()
+{
+    mRotationErrors.clear();
+    for (auto component : mComponents)
+    {
+        if (auto driver = component->GetRotationDriver())
+        {
+            driver->Compile(mRotationErrors);
+        }
+    }
+
+    for (const auto &error : mRotationErrors)
+    {
+        wxLogWarning(L"%s", error);
+    }
+
+    return mRotationErrors.empty();
+}
+
+
+/**
+ * Create the state block for a new machine.
+ *
+ * The first machine gets our own block, so with only one
+ * machine the components read their state without binding.
+ * @return State block laid out like ours
+ */
+std::shared_ptr<MachineState> MachineDefinition::CreateState()
+{
+    if (!mOwned)
+    {
+        mOwned = true;
+        mState->Save(mInitialState);
+        return mState;
+    }
+
+    return std::make_shared<MachineState>(mInitialState);
+}
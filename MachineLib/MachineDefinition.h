@@ -0,0 +1,101 @@
+/**
+ * @file MachineDefinition.h
+ * @author Shane Carr
+ *
+ * The parts of a machine that do not change as it runs.
+ */
+
+#ifndef CANADIANEXPERIENCE_MACHINELIB_MACHINEDEFINITION_H
+#define CANADIANEXPERIENCE_MACHINELIB_MACHINEDEFINITION_H
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Component.h"
+#include "ComponentGroups.h"
+#include "MachineState.h"
+
+/**
+ * The parts of a machine that do not change as it runs.
+ *
+ * The components with their geometry, images, layout and
+ * connections are built once by a machine factory and shared
+ * by every Machine built from them. All the components keep in
+ * the definition is the layout of the state block, the state
+ * itself is in each machine's own block. Another machine of a
+ * kind that already exists costs a state block and an event
+ * queue.
+ *
+ * The first machine created uses the definition's own block.
+ * The others get a copy of it as it was then.
+ */
+class MachineDefinition
+{
+private:
+    /// Components that make up the machine
+    std::vector<std::shared_ptr<Component>> mComponents;
+
+    /// The same components grouped by concrete type
+    ComponentGroups mGroups;
+
+    /// Block the components lay their state out in
+    std::shared_ptr<MachineState> mState;
+
+    /// Offset of the machine time in the state block
+    size_t mTimeOffset = 0;
+
+    /// Problems found compiling the rotation networks
+    std::vector<std::wstring> mRotationErrors;
+
+    /// The state block before any machine ran
+    MachineSnapshot mInitialState;
+
+    /// Has a machine taken our own block?
+    bool mOwned = false;
+
+public:
+    MachineDefinition();
+
+    /// Copy constructor (disabled)
+    MachineDefinition(const MachineDefinition &) = delete;
+
+    /// Assignment operator (disabled)
+    void operator=(const MachineDefinition &) = delete;
+
+    void AddComponent(std::shared_ptr<Component> component);
+    bool CompileRotation();
+    std::shared_ptr<MachineState> CreateState();
+
+    /**
+     * Get the components that make up the machine
+     * @return Components in the order they were added
+     */
+    const std::vector<std::shared_ptr<Component>> &GetComponents() const { return mComponents; }
+
+    /**
+     * Get the components grouped by concrete type
+     * @return Component groups
+     */
+    ComponentGroups &GetGroups() { return mGroups; }
+
+    /**
+     * Get the block the components lay their state out in
+     * @return Layout block
+     */
+    const MachineState &GetLayout() const { return *mState; }
+
+    /**
+     * Get the offset of the machine time in the state block
+     * @return Offset in bytes
+     */
+    size_t GetTimeOffset() const { return mTimeOffset; }
+
+    /**
+     * Get the problems found compiling the rotation networks
+     * @return Error messages
+     */
+    const std::vector<std::wstring> &GetRotationErrors() const { return mRotationErrors; }
+};
+
+#endif //CANADIANEXPERIENCE_MACHINELIB_MACHINEDEFINITION_H
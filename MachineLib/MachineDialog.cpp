@@ -0,0 +1,67 @@
+/**
+ * @file MachineDialog.cpp
+ *
+ * @author Anik Momtaz
+ * @author Charles Owen
+ */
+
+#include "pch.h"
+#include <wx/valnum.h>
+
+#include "MachineDialog.h"
+#include "IMachineSystem.h"
+
+/**
+ * Constructor
+ * @param parent Parent window
+ * @param machineSystem Machine system we are selecting a machine for
+ */
+MachineDialog::MachineDialog(wxWindow *parent, std::shared_ptr<IMachineSystem> machineSystem) :
+    wxDialog(parent, wxID_ANY, L"Machine Selector"), mMachine(machineSystem)
+{
+    mMachineNumber = mMachine->GetMachineNumber();
+
+    auto sizer = new wxBoxSizer(wxVERTICAL);
+    auto row = new wxBoxSizer(wxHORIZONTAL);
+    row->Add(new wxStaticText(this, wxID_ANY, L"Machine:"), 0, wxALIGN_CENTER_VERTICAL | wxRIGHT, 5);
+
+    wxIntegerValidator<int> validator(&mMachineNumber);
+    validator.SetMin(1);
+    mMachineNumberCtrl = new wxTextCtrl(this, wxID_ANY, wxEmptyString, wxDefaultPosition, wxDefaultSize, 0, validator);
+    row->Add(mMachineNumberCtrl, 1, wxEXPAND);
+
+    sizer->Add(row, 0, wxEXPAND | wxALL, 10);
+    sizer->Add(CreateButtonSizer(wxOK | wxCANCEL), 0, wxEXPAND | wxLEFT | wxRIGHT | wxBOTTOM, 10);
+    SetSizerAndFit(sizer);
+
+    Bind(wxEVT_BUTTON, &MachineDialog::OnOK, this, wxID_OK);
+    Bind(wxEVT_INIT_DIALOG, &MachineDialog::OnInitDialog, this);
+}
+
+
+/**
+ * Handle the dialog being shown
+ * @param event Init dialog event
+ */
+void MachineDialog::OnInitDialog(wxInitDialogEvent &event)
+{
+    TransferDataToWindow();
+    mMachineNumberCtrl->SetFocus();
+    mMachineNumberCtrl->SelectAll();
+}
+
+
+/**
+ * Handle the OK button, choosing the machine entered
+ * @param event Button event
+ */
+void MachineDialog::OnOK(wxCommandEvent &event)
+{
+    if (!Validate() || !TransferDataFromWindow())
+    {
+        return;
+    }
+
+    mMachine->ChooseMachine(mMachineNumber);
+    EndModal(wxID_OK);
+}
@@ -0,0 +1,140 @@
+/**
+ * @file MachineState.cpp
+ * @author Shane Carr
+ */
+
+#include "pch.h"
+#include <cstring>
+
+#include "MachineState.h"
+
+/// FNV-1a 64 bit offset basis
+const uint64_t FnvOffset = 14695981039346656037ull;
+
+/// FNV-1a 64 bit prime
+const uint64_t FnvPrime = 1099511628211ull;
+
+/// Layout block of the current binding on this thread
+static thread_local const MachineState *BoundLayout = nullptr;
+
+/// Block bound in its place
+static thread_local MachineState *BoundState = nullptr;
+
+
+/**
+ * Constructor
+ * @param layout Block the state is looked up in
+ * @param state Block to find it in instead
+ */
+MachineState::Binding::Binding(const MachineState &layout, MachineState &state) :
+    mPreviousLayout(BoundLayout), mPreviousState(BoundState)
+{
+    BoundLayout = &layout;
+    BoundState = &state;
+}
+
+
+/**
+ * Destructor, restores the previous binding
+ */
+MachineState::Binding::~Binding()
+{
+    BoundLayout = mPreviousLayout;
+    BoundState = mPreviousState;
+}
+
+
+/**
+ * Get the block state looked up in this one is found in
+ * @return Bound block, this one if it is not bound over
+ */
+MachineState *MachineState::Bound()
+{
+    return BoundLayout == this ? BoundState : this;
+}
+
+
+/**
+ * Get the block state looked up in this one is found in
+ * @return Bound block, this one if it is not bound over
+ */
+const MachineState *MachineState::Bound() const
+{
+    return BoundLayout == this ? BoundState : this;
+}
+
+/**
+ * Add zero filled space to the block.
+ *
+ * The vector's storage is aligned for any fundamental type,
+ * so aligning the offset is enough.
+ * @param size Size of the space in bytes
+ * @param align Alignment the space needs
+ * @return Offset of the space in the block
+ */
+size_t MachineState::Reserve(size_t size, size_t align)
+{
+    size_t offset = (mData.size() + align - 1) / align * align;
+    mData.resize(offset + size);
+    return offset;
+}
+
+
+/**
+ * Allocate space in the block and copy state into it
+ * @param data State to copy in
+ * @param size Size of the state in bytes
+ * @param align Alignment the state needs
+ * @return Offset of the state in the block
+ */
+size_t MachineState::Allocate(const std::byte *data, size_t size, size_t align)
+{
+    size_t offset = Reserve(size, align);
+    std::memcpy(mData.data() + offset, data, size);
+    return offset;
+}
+
+
+/**
+ * Copy the whole block into a snapshot
+ * @param snapshot Snapshot to fill
+ */
+void MachineState::Save(MachineSnapshot &snapshot) const
+{
+    snapshot.assign(mData.begin(), mData.end());
+}
+
+
+/**
+ * Copy a snapshot back into the block.
+ *
+ * The snapshot must come from this block or one laid out
+ * the same way. Anything else is ignored.
+ * @param snapshot Snapshot from Save
+ */
+void MachineState::Restore(const MachineSnapshot &snapshot)
+{
+    if (snapshot.size() == mData.size())
+    {
+        std::memcpy(mData.data(), snapshot.data(), mData.size());
+    }
+}
+
+
+/**
+ * Hash the whole block.
+ *
+ * FNV-1a over the bytes. Cheap enough to do every frame,
+ * the block is a few hundred bytes.
+ * @return Hash of the state
+ */
+uint64_t MachineState::Hash() const
+{
+    uint64_t hash = FnvOffset;
+    for (auto byte : mData)
+    {
+        hash = (hash ^ uint64_t(byte)) * FnvPrime;
+    }
+
+    return hash;
+}
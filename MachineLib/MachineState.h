@@ -0,0 +1,149 @@
+/**
+ * @file MachineState.h
+ * @author Shane Carr
+ *
+ * One block of plain data holding the dynamic state of a machine.
+ */
+
+#ifndef CANADIANEXPERIENCE_MACHINELIB_MACHINESTATE_H
+#define CANADIANEXPERIENCE_MACHINELIB_MACHINESTATE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+/// A copy of a state block, as saved for checkpoints
+using MachineSnapshot = std::vector<std::byte>;
+
+/**
+ * One block of plain data holding the dynamic state of a machine.
+ *
+ * Every component keeps its simulation state, rotations, angles,
+ * flags and so on, in a trivially copyable struct allocated in
+ * the block. The polygons, cylinders and images the components
+ * draw with stay in the components and read the state from here.
+ *
+ * Copying the block copies the whole simulation, so snapshots
+ * and restores are a single memcpy. Allocations are referred to
+ * by offset, since the block moves as it grows.
+ *
+ * New space is zero filled and state structs are value
+ * initialized in place, so padding is always zero and two
+ * blocks holding the same state hash the same.
+ *
+ * Machines built from one MachineDefinition share their
+ * components, and so the offsets into the definition's block.
+ * Each machine has a block of its own laid out the same way and
+ * binds it while it runs, see Binding. Until then the state
+ * is read from the definition's block itself.
+ */
+class MachineState
+{
+private:
+    /// The state data
+    std::vector<std::byte> mData;
+
+    MachineState *Bound();
+    const MachineState *Bound() const;
+
+public:
+    /**
+     * Binds a block in place of another laid out the same way,
+     * for the current thread, for as long as it exists.
+     *
+     * State looked up in the layout block is found in the bound
+     * block instead. Bindings nest, the previous one is restored
+     * when the binding goes away.
+     */
+    class Binding
+    {
+    private:
+        /// Layout block bound over before us
+        const MachineState *mPreviousLayout;
+
+        /// Block bound before us
+        MachineState *mPreviousState;
+
+    public:
+        Binding(const MachineState &layout, MachineState &state);
+        ~Binding();
+
+        /// Copy constructor (disabled)
+        Binding(const Binding &) = delete;
+
+        /// Assignment operator (disabled)
+        void operator=(const Binding &) = delete;
+    };
+
+    /// Default constructor
+    MachineState() = default;
+
+    /**
+     * Constructor
+     * @param snapshot Snapshot to start the block from
+     */
+    explicit MachineState(const MachineSnapshot &snapshot) : mData(snapshot) {}
+
+    /// Copy constructor (disabled)
+    MachineState(const MachineState &) = delete;
+
+    /// Assignment operator (disabled)
+    void operator=(const MachineState &) = delete;
+
+    size_t Reserve(size_t size, size_t align);
+    size_t Allocate(const std::byte *data, size_t size, size_t align);
+
+    /**
+     * Create state in the block with its default values
+     * @tparam T Trivially copyable state struct
+     * @return Offset of the state in the block
+     */
+    template <class T>
+    size_t Create()
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "Machine state must be trivially copyable");
+        size_t offset = Reserve(sizeof(T), alignof(T));
+        new (mData.data() + offset) T();
+        return offset;
+    }
+
+    /**
+     * Get state allocated in the block
+     * @tparam T State struct it was allocated as
+     * @param offset Offset returned by Create or Allocate
+     * @return Reference to the state in the bound block, valid
+     * until the block grows
+     */
+    template <class T>
+    T &At(size_t offset) { return *std::launder(reinterpret_cast<T *>(Bound()->mData.data() + offset)); }
+
+    /**
+     * Get state allocated in the block
+     * @tparam T State struct it was allocated as
+     * @param offset Offset returned by Create or Allocate
+     * @return Reference to the state in the bound block, valid
+     * until the block grows
+     */
+    template <class T>
+    const T &At(size_t offset) const { return *std::launder(reinterpret_cast<const T *>(Bound()->mData.data() + offset)); }
+
+    /**
+     * Get the raw state data
+     * @return Pointer to the first byte
+     */
+    const std::byte *GetData() const { return mData.data(); }
+
+    /**
+     * Get the size of the state
+     * @return Size in bytes
+     */
+    size_t GetSize() const { return mData.size(); }
+
+    void Save(MachineSnapshot &snapshot) const;
+    void Restore(const MachineSnapshot &snapshot);
+    uint64_t Hash() const;
+};
+
+#endif //CANADIANEXPERIENCE_MACHINELIB_MACHINESTATE_H
@@ -4,11 +4,91 @@
  */
 
 #include "pch.h"
+#include <mutex>
+#include <thread>
+#include <tuple>
+
 #include "MachineSystem.h"
 #include "Machine.h"
 #include "MachineCFactory.h"
 #include "Machine1Factory.h"
 #include "Machine2Factory.h"
+#include "StateHashLog.h"
+#include "SoftwareRasterizer.h"
+
+/**
+ * Build the definition of a machine.
+ * @param resourcesDir Directory containing the machine resources
+ * @param machine Machine number
+ * @return Definition, null if there is no such machine
+ */
+static std::shared_ptr<MachineDefinition> BuildDefinition(const std::wstring &resourcesDir, int machine)
+{
+    std::shared_ptr<MachineDefinition> definition;
+    if(machine == 1)
+    {
+        Machine1Factory factory(resourcesDir);
+        definition = factory.Create();
+    }
+    else if(machine == 2)
+    {
+        Machine2Factory factory(resourcesDir);
+        definition = factory.Create();
+    }
+
+    if(definition != nullptr)
+    {
+        definition->CompileRotation();
+    }
+
+    return definition;
+}
+
+
+/**
+ * Get the definition of a machine, building it only if no
+ * machine created on this thread is using one.
+ *
+ * Definitions are only shared between machines created on
+ * the same thread. Drawing caches graphics bitmaps in the
+ * polygons, and bitmaps are not shared between threads that
+ * render at once, see ImageCache.
+ * @param resourcesDir Directory containing the machine resources
+ * @param machine Machine number
+ * @return Definition, null if there is no such machine
+ */
+static std::shared_ptr<MachineDefinition> SharedDefinition(const std::wstring &resourcesDir, int machine)
+{
+    using Key = std::tuple<std::wstring, int, std::thread::id>;
+    static std::mutex mutex;
+    static std::map<Key, std::weak_ptr<MachineDefinition>> definitions;
+
+    Key key(resourcesDir, machine, std::this_thread::get_id());
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto found = definitions.find(key);
+        if (found != definitions.end())
+        {
+            if (auto definition = found->second.lock())
+            {
+                return definition;
+            }
+        }
+    }
+
+    // Only this thread builds with this key, so no need to
+    // hold the lock while building
+    auto definition = BuildDefinition(resourcesDir, machine);
+    if (definition != nullptr)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::erase_if(definitions, [](const auto &item) { return item.second.expired(); });
+        definitions[key] = definition;
+    }
+
+    return definition;
+}
+
 
 MachineSystem::MachineSystem(std::wstring resourcesDir) :
     mResourcesDir(resourcesDir)
@@ -45,23 +125,41 @@ void MachineSystem::ChooseMachine(int machine)
 {
 
     mMachineNumber = machine;
+    ClearCheckpoints();
 
-    if(machine == 1)
+    // The new machine starts at the beginning
+    mFrame = 0;
+    mTime = 0;
+
+    // Machines of the same kind share their components
+    if(auto definition = SharedDefinition(mResourcesDir, machine))
     {
-        Machine1Factory factory(mResourcesDir);
-        mMachine = factory.Create();
+        mMachine = std::make_shared<Machine>(definition);
     }
-    else if(machine == 2)
+
+    if (mHashLog != nullptr)
     {
-        Machine2Factory factory(mResourcesDir);
-        mMachine = factory.Create();
+        // A log is for one machine
+        StartHashLog();
     }
 }
 
 
 void MachineSystem::SetFrameRate(double rate)
 {
+    if (rate != mFrameRate)
+    {
+        // Saved states were stepped at the old rate
+        ClearCheckpoints();
+    }
+
     mFrameRate = rate;
+
+    if (mHashLog != nullptr && rate != mHashLog->GetFrameRate())
+    {
+        // A log is for one frame rate
+        StartHashLog();
+    }
 }
 /**
 * Set the current machine animation frame
@@ -71,17 +169,249 @@ void MachineSystem::SetMachineFrame(int frame)
 {
     if (frame < mFrame)
     {
-        mFrame = 0;
-        Reset();
+        RestoreCheckpoint(frame);
     }
 
+    double delta = 1.0 / mFrameRate;
     while (mFrame < frame) {
-        mFrame++;
-        mTime = mFrame / mFrameRate;
-        mMachine->Advance(1.0 / mFrameRate);
+        int target = FastForwardTarget(frame);
+        if (target > mFrame + 1)
+        {
+            int frames = target - mFrame;
+            mFrame = target;
+            mTime = mFrame / mFrameRate;
+            mMachine->FastForward(frames, delta, mTime);
+            mSteppedFrames += frames;
+            mFastForwardedFrames += frames;
+        }
+        else
+        {
+            mFrame++;
+            mTime = mFrame / mFrameRate;
+            mMachine->Step(delta, mTime);
+            mSteppedFrames++;
+        }
+
         mMachine->SetTime(mTime);
+
+        if (mCheckpointInterval > 0 && mFrame % mCheckpointSpacing == 0)
+        {
+            SaveCheckpoint();
+        }
+
+        if (mHashLog != nullptr)
+        {
+            LogHash();
+        }
+    }
+
+    // The crank, shafts, pulleys and cam go straight to the frame
+    mMachine->Evaluate(mTime);
+
+    // Landed on a frame without stepping, by restoring a checkpoint
+    if (mHashLog != nullptr &&
+        (mHashLog->GetEntries().empty() || mHashLog->GetEntries().back().frame != mFrame))
+    {
+        LogHash();
+    }
+}
+
+
+/**
+ * How many frames SetMachineFrame would step to get to a frame.
+ *
+ * Going forward steps from the current frame. Going backward
+ * steps from the nearest checkpoint at or before the frame,
+ * or from frame 0 if there is none. Fast-forwarded frames
+ * are counted like stepped ones.
+ * @param frame Frame to seek to
+ * @return Frame count
+ */
+int MachineSystem::GetSeekFrames(int frame) const
+{
+    if (frame >= mFrame)
+    {
+        return frame - mFrame;
+    }
+
+    auto found = mCheckpoints.upper_bound(frame);
+    if (found == mCheckpoints.begin())
+    {
+        return frame;
+    }
+
+    return frame - std::prev(found)->first;
+}
+
+
+/**
+ * Start logging the state hash of every frame landed on.
+ *
+ * Starts a new log with the current frame, replacing any log
+ * there was. Choosing another machine or frame rate starts
+ * another new log.
+ */
+void MachineSystem::StartHashLog()
+{
+    mHashLog = std::make_shared<StateHashLog>(mMachineNumber, mFrameRate);
+    LogHash();
+}
+
+
+/**
+ * Add the hash of the current frame to the log.
+ *
+ * The analytic components are brought up to date first, so
+ * the hash covers the complete state however we got here.
+ */
+void MachineSystem::LogHash()
+{
+    if (mMachine == nullptr)
+    {
+        return;
+    }
+
+    mMachine->Evaluate(mTime);
+    mHashLog->Add(mFrame, mMachine->GetState().Hash());
+}
+
+
+/**
+ * Save the machine state at the current frame, thinning
+ * the checkpoints if they go over the memory budget.
+ *
+ * If even one checkpoint is over the budget nothing is saved,
+ * until the budget is raised.
+ */
+void MachineSystem::SaveCheckpoint()
+{
+    if (mMachine == nullptr || mCheckpoints.contains(mFrame))
+    {
+        return;
+    }
+
+    if (mMachine->GetState().GetSize() > mCheckpointBudget)
+    {
+        if (!mOverBudget)
+        {
+            wxLogWarning(L"Machine state of %i bytes is over the checkpoint budget of %i bytes, not saving checkpoints",
+                    int(mMachine->GetState().GetSize()), int(mCheckpointBudget));
+            mOverBudget = true;
+        }
+
+        return;
+    }
+
+    // Bring the analytic components up to date so the
+    // checkpoint is a complete state
+    mMachine->Evaluate(mTime);
+
+    auto &state = mCheckpoints[mFrame];
+    mMachine->SaveState(state);
+    mCheckpointBytes += state.size();
+
+    // One checkpoint fits, so this stops before they are all gone
+    while (mCheckpointBytes > mCheckpointBudget)
+    {
+        mCheckpointSpacing *= 2;
+        std::erase_if(mCheckpoints, [this](const auto &item) {
+            if (item.first % mCheckpointSpacing == 0)
+            {
+                return false;
+            }
+
+            mCheckpointBytes -= item.second.size();
+            return true;
+        });
+    }
+}
+
+
+/**
+ * Go back to the nearest checkpoint at or before a frame,
+ * or to the start if there is none
+ * @param frame Frame we are seeking to
+ */
+void MachineSystem::RestoreCheckpoint(int frame)
+{
+    auto found = mCheckpoints.upper_bound(frame);
+    if (found == mCheckpoints.begin())
+    {
+        Reset();
+        return;
+    }
+
+    --found;
+    mMachine->RestoreState(found->second);
+    mFrame = found->first;
+    mTime = mFrame / mFrameRate;
+}
+
+
+/**
+ * Find how far we can fast-forward towards a frame.
+ *
+ * Stops a couple of frames short of the next predicted event,
+ * so the frames it could fall on are stepped, and at the next
+ * checkpoint so it still gets saved.
+ * @param frame Frame we are heading for
+ * @return Frame to fast-forward to, mFrame + 1 to just step
+ */
+int MachineSystem::FastForwardTarget(int frame) const
+{
+    if (!mFastForward || mMachine->IsPolling())
+    {
+        return mFrame + 1;
+    }
+
+    int target = frame;
+
+    double eventFrame = mMachine->GetNextEventTime() * mFrameRate;
+    if (eventFrame < frame + 2)
+    {
+        target = std::min(target, int(std::floor(eventFrame)) - 2);
     }
 
+    if (mCheckpointInterval > 0)
+    {
+        target = std::min(target, (mFrame / mCheckpointSpacing + 1) * mCheckpointSpacing);
+    }
+
+    return std::max(target, mFrame + 1);
+}
+
+
+/**
+ * Set how often the machine state is saved while stepping
+ * @param frames Frames between checkpoints, 0 to disable them
+ */
+void MachineSystem::SetCheckpointInterval(int frames)
+{
+    mCheckpointInterval = std::max(frames, 0);
+    ClearCheckpoints();
+}
+
+
+/**
+ * Set the memory budget for checkpoints
+ * @param bytes Most memory the checkpoints may use in bytes
+ */
+void MachineSystem::SetCheckpointBudget(size_t bytes)
+{
+    mCheckpointBudget = bytes;
+    mOverBudget = false;
+    ClearCheckpoints();
+}
+
+
+/**
+ * Discard all of the saved checkpoints
+ */
+void MachineSystem::ClearCheckpoints()
+{
+    mCheckpoints.clear();
+    mCheckpointBytes = 0;
+    mCheckpointSpacing = std::max(mCheckpointInterval, 1);
 }
 /**
  * Draw the machine
@@ -100,6 +430,21 @@ void MachineSystem::DrawMachine(std::shared_ptr<wxGraphicsContext> graphics)
 }
 
 
+/**
+ * Draw the machine with the software rasterizer
+ * @param rasterizer Rasterizer to draw into
+ */
+void MachineSystem::RasterizeMachine(SoftwareRasterizer &rasterizer)
+{
+    rasterizer.PushState();
+    rasterizer.Translate(mLocation.x, mLocation.y);
+
+    mMachine->Rasterize(rasterizer);
+
+    rasterizer.PopState();
+}
+
+
 
 
 
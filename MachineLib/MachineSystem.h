@@ -0,0 +1,199 @@
+/**
+ * @file MachineSystem.h
+ * @author Shane Carr
+ *
+ * The machine system that the application talks to.
+ */
+
+#ifndef CANADIANEXPERIENCE_MACHINELIB_MACHINESYSTEM_H
+#define CANADIANEXPERIENCE_MACHINELIB_MACHINESYSTEM_H
+
+#include <map>
+
+#include "IMachineSystem.h"
+#include "IMachineRasterizer.h"
+#include "IMachineSeek.h"
+#include "MachineState.h"
+
+class Machine;
+class StateHashLog;
+
+/**
+ * The machine system that the application talks to.
+ *
+ * Owns the current machine and steps it frame by frame to
+ * whatever frame the application asks for. Machine systems
+ * created on one thread share the components of machines of
+ * the same kind, see MachineDefinition.
+ *
+ * Going backwards would mean starting over from frame 0, so
+ * while stepping forward the full machine state is saved
+ * every few frames. A backward seek restores the nearest
+ * checkpoint at or before the frame and only steps the rest.
+ * When the checkpoints outgrow their memory budget every
+ * other one is dropped and the spacing doubles.
+ *
+ * Between predicted events nothing can change how the stateful
+ * components move, so those stretches are fast-forwarded in one
+ * jump instead of stepped frame by frame.
+ *
+ * Optionally a hash of the machine state is logged for every
+ * frame landed on, see StateHashLog.
+ *
+ * The machine can also be drawn with the software rasterizer,
+ * see IMachineRasterizer.
+ */
+class MachineSystem : public IMachineSystem, public IMachineRasterizer, public IMachineSeek
+{
+private:
+    /// Directory containing the machine resources
+    std::wstring mResourcesDir;
+
+    /// Location of the machine in the picture
+    wxPoint mLocation;
+
+    /// The current machine number
+    int mMachineNumber = 1;
+
+    /// The current machine
+    std::shared_ptr<Machine> mMachine;
+
+    /// Current frame
+    int mFrame = 0;
+
+    /// Frame rate in frames per second
+    double mFrameRate = 30;
+
+    /// Current machine time in seconds
+    double mTime = 0;
+
+    /// Frames between checkpoints as configured, 0 for none
+    int mCheckpointInterval = 30;
+
+    /// Frames between checkpoints now, grows when over budget
+    int mCheckpointSpacing = 30;
+
+    /// Most memory the checkpoints may use in bytes
+    size_t mCheckpointBudget = 4 * 1024 * 1024;
+
+    /// Memory the checkpoints use in bytes
+    size_t mCheckpointBytes = 0;
+
+    /// Has it been reported that not even one checkpoint
+    /// fits in the budget?
+    bool mOverBudget = false;
+
+    /// Saved machine state by frame
+    std::map<int, MachineSnapshot> mCheckpoints;
+
+    /// Number of frames stepped since created
+    long mSteppedFrames = 0;
+
+    /// Jump over frames with no events instead of stepping them?
+    bool mFastForward = true;
+
+    /// Number of those frames that were fast-forwarded
+    long mFastForwardedFrames = 0;
+
+    /// Hashes of the frames landed on, null when not logging
+    std::shared_ptr<StateHashLog> mHashLog;
+
+    int FastForwardTarget(int frame) const;
+    void LogHash();
+
+    void SaveCheckpoint();
+    void RestoreCheckpoint(int frame);
+
+public:
+    MachineSystem(std::wstring resourcesDir);
+
+    /// Copy constructor (disabled)
+    MachineSystem(const MachineSystem &) = delete;
+
+    /// Assignment operator (disabled)
+    void operator=(const MachineSystem &) = delete;
+
+    void SetLocation(wxPoint location) override;
+    wxPoint GetLocation() override;
+    void DrawMachine(std::shared_ptr<wxGraphicsContext> graphics) override;
+    void SetMachineFrame(int frame) override;
+    void SetFrameRate(double rate) override;
+    void ChooseMachine(int machine) override;
+    int GetMachineNumber() override;
+    double GetMachineTime() override;
+    void SetFlag(int flag) override;
+
+    void RasterizeMachine(SoftwareRasterizer &rasterizer) override;
+    int GetSeekFrames(int frame) const override;
+
+    void Reset();
+
+    void SetCheckpointInterval(int frames);
+    void SetCheckpointBudget(size_t bytes);
+    void ClearCheckpoints();
+
+    /**
+     * Set whether frames with no events are fast-forwarded
+     * @param fast true to fast-forward, false to step every frame
+     */
+    void SetFastForward(bool fast) { mFastForward = fast; }
+
+    void StartHashLog();
+
+    /**
+     * Stop logging state hashes
+     */
+    void StopHashLog() { mHashLog = nullptr; }
+
+    /**
+     * Get the state hash log
+     * @return Log, null when not logging
+     */
+    std::shared_ptr<StateHashLog> GetHashLog() const { return mHashLog; }
+
+    /**
+     * Get the current machine
+     * @return Machine pointer
+     */
+    std::shared_ptr<Machine> GetMachine() const { return mMachine; }
+
+    /**
+     * Get the current frame
+     * @return Frame number
+     */
+    int GetFrame() const { return mFrame; }
+
+    /**
+     * Number of checkpoints currently saved
+     * @return Checkpoint count
+     */
+    size_t GetCheckpointCount() const { return mCheckpoints.size(); }
+
+    /**
+     * Memory the checkpoints use
+     * @return Size in bytes
+     */
+    size_t GetCheckpointBytes() const { return mCheckpointBytes; }
+
+    /**
+     * Frames between checkpoints now
+     * @return Spacing in frames
+     */
+    int GetCheckpointSpacing() const { return mCheckpointSpacing; }
+
+    /**
+     * Number of frames stepped since the system was created,
+     * including the ones fast-forwarded over. The difference
+     * before and after a seek is its cost.
+     * @return Frame count
+     */
+    long GetSteppedFrames() const { return mSteppedFrames; }
+
+    /**
+     * Number of the stepped frames that were fast-forwarded
+     * @return Frame count
+     */
+    long GetFastForwardedFrames() const { return mFastForwardedFrames; }
+};
+
+#endif //CANADIANEXPERIENCE_MACHINELIB_MACHINESYSTEM_H
@@ -0,0 +1,53 @@
+/**
+ * @file MachineSystemStandin.h
+ *
+ * @author Charles Owen
+ *
+ * Stand-in machine system that draws a placeholder machine.
+ */
+
+#ifndef CANADIANEXPERIENCE_MACHINESYSTEMSTANDIN_H
+#define CANADIANEXPERIENCE_MACHINESYSTEMSTANDIN_H
+
+#include "IMachineSystem.h"
+
+class MachineStandin;
+
+/**
+ * Stand-in machine system that draws a placeholder machine.
+ *
+ * Lets the machine adapter be developed before the real
+ * machine system exists.
+ */
+class MachineSystemStandin : public IMachineSystem
+{
+private:
+    /// The stand-in machine
+    std::shared_ptr<MachineStandin> mStandin;
+
+public:
+    MachineSystemStandin();
+
+    /// Copy constructor (disabled)
+    MachineSystemStandin(const MachineSystemStandin &) = delete;
+
+    /// Assignment operator (disabled)
+    void operator=(const MachineSystemStandin &) = delete;
+
+    void SetLocation(wxPoint location) override;
+    wxPoint GetLocation() override;
+    void DrawMachine(std::shared_ptr<wxGraphicsContext> graphics) override;
+    void SetMachineFrame(int frame) override;
+    void SetFrameRate(double rate) override;
+    void ChooseMachine(int machine) override;
+    int GetMachineNumber() override;
+    double GetMachineTime() override;
+
+    /**
+     * Set a flag for testing (the stand-in has none)
+     * @param flag Flag value
+     */
+    void SetFlag(int flag) override {}
+};
+
+#endif //CANADIANEXPERIENCE_MACHINESYSTEMSTANDIN_H
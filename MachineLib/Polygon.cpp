@@ -15,13 +15,16 @@
 #include <wx/hyperlink.h>
 #include <wx/generic/hyperlink.h>
 #include "Polygon.h"
+#include "ImageCache.h"
+#include "LevelOfDetail.h"
+#include "SoftwareRasterizer.h"
 
 using namespace cse335;
 
 /**
  * Constructor
  */
-Polygon::Polygon() : mBrush(*wxBLACK)
+Polygon::Polygon() : mBrush(wxColour(0, 0, 0))
 {
 }
 
@@ -204,11 +207,14 @@ void Polygon::SetColor(wxColour color)
  */
 void Polygon::SetImage(std::wstring filename)
 {
-    // Prevent error popup from wxWidgets
-    wxLogNull logNo;
+    {
+        // Prevent error popup from wxWidgets
+        wxLogNull logNo;
+        mImage = ImageCache::Get().Load(filename);
+    }
 
-    mImage = std::make_unique<wxImage>();
-    if(mImage->LoadFile(filename, wxBITMAP_TYPE_ANY))
+    mBitmapDirty = true;
+    if(mImage->IsOk())
     {
         mMode = Mode::Image;
     }
@@ -216,7 +222,16 @@ void Polygon::SetImage(std::wstring filename)
     {
         std::wstringstream str;
         str << L"Unable to load '" << filename << "'" << std::endl;
-        wxMessageBox(str.str(), L"Polygon Image File Load Failure!");
+        if (wxIsMainThread())
+        {
+            wxMessageBox(str.str(), L"Polygon Image File Load Failure!");
+        }
+        else
+        {
+            // Machines built by export workers can't show dialogs,
+            // the log passes this on to the main thread instead
+            wxLogError(L"%s", str.str());
+        }
         mImage = nullptr;
     }
 }
@@ -279,6 +294,29 @@ void Polygon::DrawPolygon(std::shared_ptr<wxGraphicsContext> graphics, double x,
 
 
 
+/**
+ * Circles that are small on screen skip points. Get the
+ * stride to use, which divides the points evenly.
+ * @param scale Pixels per unit
+ * @return Use every how many points, 1 for all of them
+ */
+size_t Polygon::CircleStride(double scale)
+{
+    size_t stride = 1;
+    if(mIsCircle)
+    {
+        auto steps = LevelOfDetail::Get().CircleSteps(int(mPoints.size()), Radius(), scale);
+        stride = std::max(size_t(1), mPoints.size() / size_t(steps));
+        while(mPoints.size() % stride != 0)
+        {
+            stride--;
+        }
+    }
+
+    return stride;
+}
+
+
 /**
  * Draw the polygon as a solid color-filled polygon
  * @param graphics Graphics object to draw on
@@ -288,13 +326,15 @@ void Polygon::DrawPolygon(std::shared_ptr<wxGraphicsContext> graphics, double x,
  */
 void Polygon::DrawColorPolygon(std::shared_ptr<wxGraphicsContext> graphics, double x, double y, double rotation)
 {
-    if(mPath.IsNull())
+    size_t stride = CircleStride(LevelOfDetail::Scale(graphics));
+    if(mPath.IsNull() || stride != mPathStride)
     {
         // Create the graphics path
         mPath = graphics->CreatePath();
+        mPathStride = stride;
 
         mPath.MoveToPoint(mPoints[0].m_x, mPoints[0].m_y);
-        for(size_t i=1; i<mPoints.size(); i++)
+        for(size_t i=stride; i<mPoints.size(); i+=stride)
         {
             mPath.AddLineToPoint(mPoints[i].m_x, mPoints[i].m_y);
         }
@@ -331,13 +371,14 @@ void Polygon::DrawImagePolygon(std::shared_ptr<wxGraphicsContext> graphics, doub
         // Implementation of opacity for Windows systems.
         // Windows does not support transparency layers.
         if(mOpacity < 1) {
+            // The cached image is shared, so work on a copy
+            wxImage img = mImage->Copy();
+
             // Ensure the image has an alpha map
-            if (!mImage->HasAlpha()) {
-                mImage->InitAlpha();
+            if (!img.HasAlpha()) {
+                img.InitAlpha();
             }
 
-            wxImage img = mImage->Copy();
-
             unsigned char *alpha = img.GetAlpha();
             for(int i=0; i<img.GetWidth()*img.GetHeight(); i++)
             {
@@ -348,10 +389,10 @@ void Polygon::DrawImagePolygon(std::shared_ptr<wxGraphicsContext> graphics, doub
         }
         else
         {
-            mGraphicsBitmap = graphics->CreateBitmapFromImage(*mImage);
+            mGraphicsBitmap = ImageCache::Get().GetBitmap(graphics, mImage);
         }
 #else
-        mGraphicsBitmap = graphics->CreateBitmapFromImage(*mImage);
+        mGraphicsBitmap = ImageCache::Get().GetBitmap(graphics, mImage);
 #endif
 
         //
@@ -416,6 +457,95 @@ void Polygon::DrawImagePolygon(std::shared_ptr<wxGraphicsContext> graphics, doub
     graphics->PopState();
 }
 
+
+/**
+ * Draw the polygon with the software rasterizer.
+ *
+ * Image polygons draw the image over the bounding rectangle
+ * of the points clipped to the polygon, like DrawImagePolygon.
+ * @param rasterizer Rasterizer to draw into
+ * @param x X location to draw the polygon
+ * @param y Y location to draw the polygon
+ * @param rotation Rotation in turns, where 0-1 is one revolution
+ */
+void Polygon::Rasterize(SoftwareRasterizer &rasterizer, double x, double y, double rotation)
+{
+    if(mPoints.size() < 3)
+    {
+        Assert(false,
+               L"You must specify a shape when using Polygon. At least three points must be provided.",
+               L"https://cse335.egr.msu.edu/polygon/c/");
+        return;
+    }
+
+    mHasDrawn = true;
+
+    rasterizer.PushState();
+
+    rasterizer.Translate(x, y);
+    rasterizer.Rotate(rotation * M_PI * 2);
+
+    switch (mMode) {
+        case Mode::Color:
+        {
+            size_t stride = CircleStride(LevelOfDetail::Scale(rasterizer));
+            if(stride == 1)
+            {
+                rasterizer.FillPolygon(mPoints, mBrush.GetColour(), mOpacity);
+            }
+            else
+            {
+                std::vector<wxPoint2DDouble> points;
+                for(size_t i=0; i<mPoints.size(); i+=stride)
+                {
+                    points.push_back(mPoints[i]);
+                }
+
+                rasterizer.FillPolygon(points, mBrush.GetColour(), mOpacity);
+            }
+            break;
+        }
+
+        case Mode::Image:
+        {
+            auto topLeft = mPoints[0];
+            auto bottomRight = mPoints[0];
+            for(auto point : mPoints)
+            {
+                topLeft.m_x = std::min(topLeft.m_x, point.m_x);
+                topLeft.m_y = std::min(topLeft.m_y, point.m_y);
+                bottomRight.m_x = std::max(bottomRight.m_x, point.m_x);
+                bottomRight.m_y = std::max(bottomRight.m_y, point.m_y);
+            }
+
+            rasterizer.Clip(mPoints);
+
+            auto size = bottomRight - topLeft;
+            rasterizer.Translate(topLeft.m_x, topLeft.m_y);
+            if(mInvertedY)
+            {
+                // Flip the image upside down
+                rasterizer.Scale(1, -1);
+                rasterizer.DrawImage(mImage, 0, -size.m_y, size.m_x, size.m_y, mOpacity);
+            }
+            else
+            {
+                rasterizer.DrawImage(mImage, 0, 0, size.m_x, size.m_y, mOpacity);
+            }
+            break;
+        }
+
+        default:
+            Assert(false,
+                   L"You must specify either a color or an image when using Polygon",
+                   L"https://cse335.egr.msu.edu/polygon/c/");
+            break;
+    }
+
+    rasterizer.PopState();
+}
+
+
 /**
  * Convenience function to draw a crosshair.
  * @param graphics Graphics object to draw on
@@ -25,6 +25,8 @@
 #include <memory>
 #include <string>
 
+class SoftwareRasterizer;
+
 namespace cse335 {
 
 /**
@@ -38,10 +40,14 @@ namespace cse335 {
 
         void DrawColorPolygon(std::shared_ptr<wxGraphicsContext> graphics, double x, double y, double rotation);
         void DrawImagePolygon(std::shared_ptr<wxGraphicsContext> graphics, double x, double y, double rotation);
+        size_t CircleStride(double scale);
 
         /// Graphics path to use to draw
         wxGraphicsPath mPath;
 
+        /// Circles only: every how many points mPath uses
+        size_t mPathStride = 1;
+
         /// The points that make up the polygon
         std::vector<wxPoint2DDouble> mPoints;
 
@@ -59,8 +65,8 @@ namespace cse335 {
         /// The current mode
         Mode mMode = Mode::Unset;
 
-        /// The basic texture image we load
-        std::unique_ptr<wxImage> mImage;
+        /// The basic texture image we load, shared through the image cache
+        std::shared_ptr<const wxImage> mImage;
 
         /// The graphics bitmap we actually draw
         wxGraphicsBitmap mGraphicsBitmap;
@@ -144,6 +150,8 @@ namespace cse335 {
 
         void DrawPolygon(std::shared_ptr<wxGraphicsContext> graphics, double x, double y, double rotation=0);
 
+        void Rasterize(SoftwareRasterizer &rasterizer, double x, double y, double rotation=0);
+
         virtual void SetOpacity(double opacity);
 
         int GetImageWidth();
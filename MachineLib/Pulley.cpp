@@ -5,6 +5,7 @@
 
 #include "pch.h"
 #include "Pulley.h"
+#include "SoftwareRasterizer.h"
 
 ///width of the pulley
 const double PulleyHubWidth = 3;
@@ -12,11 +13,12 @@ const double PulleyHubWidth = 3;
 /// How deep the belt is into the pulley
 const double PulleyBeltDepth = 3;
 
-/// The color to use for pulleys
-const wxColour PulleyColor = wxColour(205, 250, 5);
+/// The color to use for pulleys. One per thread, so pulleys
+/// built on different threads don't share colour data.
+thread_local const wxColour PulleyColor = wxColour(205, 250, 5);
 
 /// The line color to use for the hub
-const wxColour PulleyHubLineColor = wxColour(139, 168, 7);
+thread_local const wxColour PulleyHubLineColor = wxColour(139, 168, 7);
 
 /// The width to draw the lines on the hub
 const int PulleyHubLineWidth = 4;
@@ -27,6 +29,8 @@ const double PulleyHubLineCountDiviser = 6.0;
 // In Pulley.cpp
 Pulley::Pulley(double radius)
 {
+    InitState<PulleyState>();
+
     mRadius = radius;
     // Calculate number of lines based on diameter
     int numLines = int((mRadius * 2) / PulleyHubLineCountDiviser);
@@ -44,13 +48,13 @@ Pulley::Pulley(double radius)
     mBody.SetColour(PulleyColor);
     mBody.SetSize(mRadius * 1.5 - PulleyBeltDepth, PulleyHubWidth*3);
 
-    mBelt.SetColour(*wxBLACK);
+    mBelt.SetColour(wxColour(0, 0, 0));
     mBelt.SetSize(PulleyBeltDepth, 0);
 }
 
 void Pulley::SetRotation(double rotation)
 {
-    mRotation = rotation;
+    GetState<PulleyState>().rotation = rotation;
     mSource.SetRotation(rotation);
 
     if (mBeltConnectedPulley != nullptr)
@@ -63,20 +67,39 @@ void Pulley::SetRotation(double rotation)
     }
 }
 
+void Pulley::ApplyRotation(double rotation)
+{
+    GetState<PulleyState>().rotation = rotation;
+}
+
+void Pulley::GetDriven(std::vector<Driven> &driven)
+{
+    for (auto sink : mSource.GetSinks())
+    {
+        driven.push_back(Driven(sink, 1));
+    }
+
+    if (mBeltConnectedPulley != nullptr)
+    {
+        driven.push_back(Driven(mBeltConnectedPulley, mRadius / mBeltConnectedPulley->GetRadius()));
+    }
+}
+
 void Pulley::Draw(std::shared_ptr<wxGraphicsContext> graphics)
 {
+    double rotation = GetRotation();
 
     graphics->PushState();
 
     graphics->Translate(GetX(), GetY());
 
-    mBody.Draw(graphics, -2.75, 0, mRotation);
+    mBody.Draw(graphics, -2.75, 0, rotation);
 
     // Draw the left hub
-    mLeftHub.Draw(graphics, -PulleyHubWidth * 2, 0, mRotation);
+    mLeftHub.Draw(graphics, -PulleyHubWidth * 2, 0, rotation);
 
     // Draw the right hub
-    mRightHub.Draw(graphics, PulleyHubWidth * 2, 0, mRotation);
+    mRightHub.Draw(graphics, PulleyHubWidth * 2, 0, rotation);
 
     graphics->PopState();
 
@@ -87,6 +110,29 @@ void Pulley::DrawForeground(std::shared_ptr<wxGraphicsContext> graphics)
     DrawBelt(graphics);
 }
 
+void Pulley::Rasterize(SoftwareRasterizer &rasterizer)
+{
+    double rotation = GetRotation();
+
+    rasterizer.PushState();
+    rasterizer.Translate(GetX(), GetY());
+
+    mBody.Rasterize(rasterizer, -2.75, 0, rotation);
+    mLeftHub.Rasterize(rasterizer, -PulleyHubWidth * 2, 0, rotation);
+    mRightHub.Rasterize(rasterizer, PulleyHubWidth * 2, 0, rotation);
+
+    rasterizer.PopState();
+}
+
+void Pulley::RasterizeForeground(SoftwareRasterizer &rasterizer)
+{
+    double x, y;
+    if(PlaceBelt(x, y))
+    {
+        mBelt.Rasterize(rasterizer, x, y, GetRotation());
+    }
+}
+
 void Pulley::Update(double elapsed)
 {
     // Nothing to update - rotation comes from source
@@ -94,33 +140,46 @@ void Pulley::Update(double elapsed)
 
 void Pulley::DrawBelt(std::shared_ptr<wxGraphicsContext> graphics)
 {
-    if(mBeltConnectedPulley != nullptr)
+    double x, y;
+    if(PlaceBelt(x, y))
     {
         graphics->PushState();
+        mBelt.Draw(graphics, x, y, GetRotation());
+        graphics->PopState();
+    }
+}
 
-        double y1 = GetY();  // First pulley location
-        double y2 = mBeltConnectedPulley->GetY();  // Second pulley location
 
-        // Base center-to-center distance
-        double diff = mRadius + mBeltConnectedPulley->GetRadius()-10;
-        double beltHeight = abs(y2 - y1) + diff;
-        mBelt.SetSize(beltHeight, PulleyHubWidth*3);
+/**
+ * Size the belt to reach the connected pulley and find where
+ * it is drawn
+ * @param x Set to the X location of the belt
+ * @param y Set to the Y location of the belt
+ * @return false if there is no belt
+ */
+bool Pulley::PlaceBelt(double &x, double &y)
+{
+    if(mBeltConnectedPulley == nullptr)
+    {
+        return false;
+    }
 
-        // Draw from midpoint between the two pulleys
-        double midpointY = (y1 + y2) / 2;
-        double offset = (mRadius - mBeltConnectedPulley->GetRadius())/2;
+    double y1 = GetY();  // First pulley location
+    double y2 = mBeltConnectedPulley->GetY();  // Second pulley location
 
-        mBelt.SetLines(*wxWHITE, 2, 5);
+    // Base center-to-center distance
+    double diff = mRadius + mBeltConnectedPulley->GetRadius()-10;
+    double beltHeight = abs(y2 - y1) + diff;
+    mBelt.SetSize(beltHeight, PulleyHubWidth*3);
 
+    // Draw from midpoint between the two pulleys
+    double midpointY = (y1 + y2) / 2;
+    double offset = (mRadius - mBeltConnectedPulley->GetRadius())/2;
 
-        if (y1 > y2){
-            mBelt.Draw(graphics, GetX() - 2.75, midpointY + offset, mRotation);
-        }
-        else{
-            mBelt.Draw(graphics, GetX() - 2.75, midpointY - offset, mRotation);
-        }
+    mBelt.SetLines(wxColour(255, 255, 255), 2, 5);
 
+    x = GetX() - 2.75;
+    y = y1 > y2 ? midpointY + offset : midpointY - offset;
+    return true;
+}
 
-        graphics->PopState();
-    }
-}
\ No newline at end of file
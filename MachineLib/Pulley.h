@@ -21,6 +21,13 @@
 class Pulley : public Component, public RotationSink
 {
 private:
+    /// Simulation state of the pulley
+    struct PulleyState : ComponentState
+    {
+        /// Current rotation of the pulley in turns
+        double rotation = 0;
+    };
+
     /// Radius of the pulley
     double mRadius = 20;
 
@@ -33,9 +40,6 @@ private:
     /// Main body cylinder of the pulley
     cse335::Cylinder mBody;
 
-    /// Current rotation of the pulley in turns
-    double mRotation = 0;
-
     /// Rotation source for transmitting rotation to other components
     RotationSource mSource;
 
@@ -45,6 +49,8 @@ private:
     /// The belt cylinder that visually connects two pulleys
     cse335::Cylinder mBelt;
 
+    bool PlaceBelt(double &x, double &y);
+
 public:
     /**
      * Constructor for a pulley component.
@@ -64,6 +70,12 @@ public:
      */
     double GetRadius() const { return mRadius; }
 
+    /**
+     * Get the rotation of the pulley.
+     * @return Rotation in turns
+     */
+    double GetRotation() const { return GetState<PulleyState>().rotation; }
+
     /// Copy constructor (disabled)
     Pulley(const Pulley &) = delete;
 
@@ -82,12 +94,30 @@ public:
      */
     void DrawForeground(std::shared_ptr<wxGraphicsContext> graphics) override;
 
+    /**
+     * Draw the pulley component with the software rasterizer.
+     * @param rasterizer Rasterizer to draw into.
+     */
+    void Rasterize(SoftwareRasterizer &rasterizer) override;
+
+    /**
+     * Draw the belt with the software rasterizer.
+     * @param rasterizer Rasterizer to draw into.
+     */
+    void RasterizeForeground(SoftwareRasterizer &rasterizer) override;
+
     /**
      * Update the pulley state over time.
      * @param elapsed Time elapsed since the last update, in seconds.
      */
     void Update(double elapsed) override;
 
+    /**
+     * The pulley only turns with its rotation source.
+     * @return true
+     */
+    bool IsAnalytic() const override { return true; }
+
     /**
      * Drive another pulley by connecting them.
      * @param pulley Pulley to drive.
@@ -109,6 +139,19 @@ public:
      */
     void SetRotation(double rotation)override;
 
+    /**
+     * Set the rotation without passing it on.
+     * @param rotation New rotation value in turns.
+     */
+    void ApplyRotation(double rotation) override;
+
+    /**
+     * Get the sinks this pulley turns, including the pulley on
+     * the other end of its belt.
+     * @param driven Collection to add the driven sinks to.
+     */
+    void GetDriven(std::vector<Driven> &driven) override;
+
     /**
      * Connect this pulley to another pulley using a belt.
      * @param pulley Pulley to connect to.
@@ -7,6 +7,11 @@
 
 #ifndef CANADIANEXPERIENCE_MACHINELIB_ROTATIONSINK_H
 #define CANADIANEXPERIENCE_MACHINELIB_ROTATIONSINK_H
+
+#include <optional>
+#include <utility>
+#include <vector>
+
 /**
  *  Interface class to handle updating the rotation of components being rotated.
  */
@@ -25,6 +30,23 @@ public:
     /// @param rotation Rotation in turns
     virtual void SetRotation(double rotation) = 0;
 
+    /// A sink driven by this one and the ratio of its rotation to ours
+    using Driven = std::pair<RotationSink*, double>;
+
+    /// Get the sinks this sink drives when it turns
+    /// @param driven Collection to add the driven sinks to
+    virtual void GetDriven(std::vector<Driven> &driven) {}
+
+    /// Set the rotation of this sink only, without passing it
+    /// on. Used by a compiled rotation plan, which visits the
+    /// driven sinks itself.
+    /// @param rotation Rotation in turns
+    virtual void ApplyRotation(double rotation) { SetRotation(rotation); }
+
+    /// Get the rotation at which this sink will fire an event
+    /// @return Rotation in turns, or nothing if no event is pending
+    virtual std::optional<double> GetTriggerRotation() const { return std::nullopt; }
+
     virtual ~RotationSink() = default;
 };
 #endif //CANADIANEXPERIENCE_MACHINELIB_ROTATIONSINK_H
@@ -0,0 +1,72 @@
+/**
+ * @file RotationSource.cpp
+ * @author Shane Carr
+ */
+
+#include "pch.h"
+#include <functional>
+#include <set>
+
+#include "RotationSource.h"
+
+/**
+ * Compile the network driven by this source into a plan.
+ *
+ * A sink reached twice is either in a cycle or driven by two
+ * things at once. Both are reported and leave the source
+ * uncompiled, so it keeps passing rotation on the old way.
+ * @param errors Collection to add any problems to
+ * @return true if compiled
+ */
+bool RotationSource::Compile(std::vector<std::wstring> &errors)
+{
+    mPlan.clear();
+    mCompiled = false;
+
+    std::set<RotationSink*> visited;
+    std::set<RotationSink*> path;
+    bool ok = true;
+
+    std::function<void(RotationSink*, double)> visit = [&](RotationSink *sink, double ratio) {
+        if (path.contains(sink))
+        {
+            errors.push_back(L"Rotation cycle: a sink ends up driving itself");
+            ok = false;
+            return;
+        }
+
+        if (visited.contains(sink))
+        {
+            errors.push_back(L"Rotation conflict: a sink is driven by more than one source or belt");
+            ok = false;
+            return;
+        }
+
+        visited.insert(sink);
+        mPlan.push_back(RotationSink::Driven(sink, ratio));
+
+        std::vector<RotationSink::Driven> driven;
+        sink->GetDriven(driven);
+
+        path.insert(sink);
+        for (const auto &[next, nextRatio] : driven)
+        {
+            visit(next, ratio * nextRatio);
+        }
+        path.erase(sink);
+    };
+
+    for (auto sink : mSinks)
+    {
+        visit(sink, 1);
+    }
+
+    if (!ok)
+    {
+        mPlan.clear();
+        return false;
+    }
+
+    mCompiled = true;
+    return true;
+}
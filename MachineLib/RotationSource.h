@@ -7,19 +7,29 @@
 
 #ifndef CANADIANEXPERIENCE_MACHINELIB_ROTATIONSOURCE_H
 #define CANADIANEXPERIENCE_MACHINELIB_ROTATIONSOURCE_H
+#include <string>
 #include <vector>
 #include "RotationSink.h"
 /**
  *  Class that allows a component to give rotation to another component
+ *
+ * A source that drives a whole network of sinks can be compiled
+ * once the network is built. Compiling walks the sources, sinks
+ * and belts into a flat list of every sink reached with its
+ * rotation ratio to us, ordered so drivers come before the sinks
+ * they drive. SetRotation then sets each sink in one loop.
  */
 class RotationSource {
 private:
-    /// The current rotation in turns
-    double mRotation = 0;
-
     /// Collection of rotation sinks that receive our rotation
     std::vector<RotationSink*> mSinks;
 
+    /// Every sink we drive with its ratio, drivers first
+    std::vector<RotationSink::Driven> mPlan;
+
+    /// Is mPlan in use?
+    bool mCompiled = false;
+
 public:
     /// Default constructor
     RotationSource() = default;
@@ -32,13 +42,25 @@ public:
 
     /// Add a sink to be rotated by this source
     /// @param sink The sink to add
-    void AddSink(RotationSink* sink) { mSinks.push_back(sink); }
+    void AddSink(RotationSink* sink) { mSinks.push_back(sink); mCompiled = false; }
+
+    /// Get the sinks rotated by this source
+    /// @return Sinks in the order they were added
+    const std::vector<RotationSink*> &GetSinks() const { return mSinks; }
 
     /// Set the rotation and update all sinks
     /// @param rotation Rotation in turns
     void SetRotation(double rotation)
     {
-        mRotation = rotation;
+        if (mCompiled)
+        {
+            for (const auto &[sink, ratio] : mPlan)
+            {
+                sink->ApplyRotation(rotation * ratio);
+            }
+            return;
+        }
+
         // Update all connected sinks
         for (auto sink : mSinks)
         {
@@ -46,8 +68,14 @@ public:
         }
     }
 
-    /// Get the current rotation
-    /// @return Rotation in turns
-    double GetRotation() const { return mRotation; }
+    bool Compile(std::vector<std::wstring> &errors);
+
+    /// Is the source using a compiled plan?
+    /// @return true if compiled
+    bool IsCompiled() const { return mCompiled; }
+
+    /// Get the compiled plan
+    /// @return Sinks with their ratio to this source, drivers first
+    const std::vector<RotationSink::Driven> &GetPlan() const { return mPlan; }
 };
 #endif //CANADIANEXPERIENCE_MACHINELIB_ROTATIONSOURCE_H
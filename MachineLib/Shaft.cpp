@@ -5,12 +5,14 @@
 
 #include "pch.h"
 #include "Shaft.h"
+#include "SoftwareRasterizer.h"
 
-/// The color to draw the shaft
-const wxColour ShaftColor = wxColour(220, 220, 220);
+/// The color to draw the shaft, per thread like the other
+/// component colours
+thread_local const wxColour ShaftColor = wxColour(220, 220, 220);
 
 /// The color to draw the lines on the shaft
-const wxColour ShaftLineColor = wxColour(100, 100, 100);
+thread_local const wxColour ShaftLineColor = wxColour(100, 100, 100);
 
 /// The width to draw the lines on the shaft
 const int ShaftLinesWidth = 1;
@@ -24,6 +26,8 @@ const int ShaftNumLines = 4;
  */
 Shaft::Shaft(double length)
 {
+    InitState<ShaftState>();
+
     // Configure the rod (cylinder)
     mRod.SetColour(ShaftColor);
     mRod.SetLines(ShaftLineColor, ShaftLinesWidth, ShaftNumLines);
@@ -35,12 +39,22 @@ void Shaft::Draw(std::shared_ptr<wxGraphicsContext> graphics)
     graphics->PushState();
     graphics->Translate(GetX(), GetY());
 
-    mRod.Draw(graphics, 0, 0, mRotation);
+    mRod.Draw(graphics, 0, 0, GetRotation());
 
 
     graphics->PopState();
 }
 
+void Shaft::Rasterize(SoftwareRasterizer &rasterizer)
+{
+    rasterizer.PushState();
+    rasterizer.Translate(GetX(), GetY());
+
+    mRod.Rasterize(rasterizer, 0, 0, GetRotation());
+
+    rasterizer.PopState();
+}
+
 void Shaft::DrawForeground(std::shared_ptr<wxGraphicsContext> graphics)
 {
     // Nothing to draw in foreground
@@ -50,3 +64,4 @@ void Shaft::Update(double elapsed)
 {
     // Nothing to update - rotation comes from Crank
 }
+
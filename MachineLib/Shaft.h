@@ -22,12 +22,16 @@
 class Shaft : public Component, public RotationSink
 {
 private:
+    /// Simulation state of the shaft
+    struct ShaftState : ComponentState
+    {
+        /// Current rotation of the shaft in turns (set by Crank)
+        double rotation = 0;
+    };
+
     /// The cylinder used to render the shaft visually
     cse335::Cylinder mRod;
 
-    /// Current rotation of the shaft in turns (set by Crank)
-    double mRotation = 0;
-
     /// Rotation source to propagate rotation to connected components
     RotationSource mSource;
 
@@ -56,12 +60,30 @@ public:
      */
     void DrawForeground(std::shared_ptr<wxGraphicsContext> graphics) override;
 
+    /**
+     * Draw the shaft component with the software rasterizer.
+     * @param rasterizer Rasterizer to draw into.
+     */
+    void Rasterize(SoftwareRasterizer &rasterizer) override;
+
+    /**
+     * Draw the foreground elements of the shaft with the software rasterizer.
+     * @param rasterizer Rasterizer to draw into.
+     */
+    void RasterizeForeground(SoftwareRasterizer &rasterizer) override {}
+
     /**
      * Update the shaft state over time.
      * @param elapsed time past
      */
     void Update(double elapsed) override;
 
+    /**
+     * The shaft only turns with its rotation source.
+     * @return true
+     */
+    bool IsAnalytic() const override { return true; }
+
     /**
      * Get the source of rotation for the shaft.
      * @return Pointer to the RotationSource object.
@@ -74,9 +96,33 @@ public:
      */
     void SetRotation(double rotation) override
     {
-        mRotation = rotation;
+        GetState<ShaftState>().rotation = rotation;
         mSource.SetRotation(rotation);  // Pass rotation to any connected components
     }
+
+    /**
+     * Set the rotation without passing it on.
+     * @param rotation The new rotation value in turns.
+     */
+    void ApplyRotation(double rotation) override { GetState<ShaftState>().rotation = rotation; }
+
+    /**
+     * Get the rotation of the shaft.
+     * @return Rotation in turns
+     */
+    double GetRotation() const { return GetState<ShaftState>().rotation; }
+
+    /**
+     * Get the sinks the shaft turns.
+     * @param driven Collection to add the driven sinks to
+     */
+    void GetDriven(std::vector<Driven> &driven) override
+    {
+        for (auto sink : mSource.GetSinks())
+        {
+            driven.push_back(Driven(sink, 1));
+        }
+    }
 };
 
 #endif //CANADIANEXPERIENCE_MACHINELIB_SHAFT_H
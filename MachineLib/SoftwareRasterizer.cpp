@@ -0,0 +1,854 @@
+/**
+ * @file SoftwareRasterizer.cpp
+ * @author Shane Carr
+ */
+
+#include "pch.h"
+#include <algorithm>
+#include <cmath>
+
+#include "SoftwareRasterizer.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SOFTWARE_RASTERIZER_SSE2
+#include <emmintrin.h>
+#endif
+
+/// Vertical samples per pixel when computing polygon coverage
+const int Subsamples = 4;
+
+/// Bilinear weights are in units of 1/128
+const int WeightShift = 7;
+
+/**
+ * Divide by 255 with rounding, exact for 0 to 255 * 255
+ * @param x Value to divide
+ * @return x / 255 rounded
+ */
+static inline uint32_t Div255(uint32_t x)
+{
+    x += 128;
+    return (x + (x >> 8)) >> 8;
+}
+
+
+/**
+ * Pack channels into a pixel
+ * @param r Red
+ * @param g Green
+ * @param b Blue
+ * @param a Alpha
+ * @return Pixel with bytes R, G, B, A in memory order
+ */
+static inline uint32_t Pack(uint32_t r, uint32_t g, uint32_t b, uint32_t a)
+{
+    return r | (g << 8) | (b << 16) | (a << 24);
+}
+
+
+/**
+ * Premultiply a color
+ * @param color Color to convert
+ * @param opacity Additional opacity from 0 to 1
+ * @return Premultiplied pixel
+ */
+static uint32_t Premultiply(const wxColour &color, double opacity)
+{
+    uint32_t a = uint32_t(lround(color.Alpha() * std::clamp(opacity, 0.0, 1.0)));
+    return Pack(Div255(color.Red() * a), Div255(color.Green() * a), Div255(color.Blue() * a), a);
+}
+
+
+/**
+ * Scale every channel of a premultiplied pixel
+ * @param pixel Pixel to scale
+ * @param k Scale from 0 to 255
+ * @return Scaled pixel
+ */
+static inline uint32_t ScalePixel(uint32_t pixel, uint32_t k)
+{
+    return Pack(Div255((pixel & 0xff) * k), Div255(((pixel >> 8) & 0xff) * k),
+            Div255(((pixel >> 16) & 0xff) * k), Div255((pixel >> 24) * k));
+}
+
+
+/**
+ * Draw a premultiplied pixel over another
+ * @param src Pixel to draw
+ * @param dst Pixel already there
+ * @return Blended pixel
+ */
+static inline uint32_t Over(uint32_t src, uint32_t dst)
+{
+    uint32_t inv = 255 - (src >> 24);
+    uint32_t result = 0;
+    for (int shift = 0; shift < 32; shift += 8)
+    {
+        uint32_t channel = ((src >> shift) & 0xff) + Div255(((dst >> shift) & 0xff) * inv);
+        result |= std::min(channel, 255u) << shift;
+    }
+
+    return result;
+}
+
+
+#ifdef SOFTWARE_RASTERIZER_SSE2
+/**
+ * Divide 16 bit lanes by 255 with rounding
+ * @param x Lanes to divide
+ * @return x / 255 rounded
+ */
+static inline __m128i Div255(__m128i x)
+{
+    x = _mm_add_epi16(x, _mm_set1_epi16(128));
+    return _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+}
+
+
+/**
+ * Copy the alpha of each of two 16 bit pixels into all its lanes
+ * @param x Two pixels in 16 bit lanes
+ * @return Alpha broadcast
+ */
+static inline __m128i BroadcastAlpha(__m128i x)
+{
+    x = _mm_shufflelo_epi16(x, _MM_SHUFFLE(3, 3, 3, 3));
+    return _mm_shufflehi_epi16(x, _MM_SHUFFLE(3, 3, 3, 3));
+}
+
+
+/**
+ * Draw four premultiplied pixels over four others
+ * @param src Pixels to draw
+ * @param dst Pixels already there
+ * @return Blended pixels
+ */
+static inline __m128i Over4(__m128i src, __m128i dst)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i full = _mm_set1_epi16(255);
+
+    __m128i invLo = _mm_sub_epi16(full, BroadcastAlpha(_mm_unpacklo_epi8(src, zero)));
+    __m128i invHi = _mm_sub_epi16(full, BroadcastAlpha(_mm_unpackhi_epi8(src, zero)));
+
+    __m128i lo = Div255(_mm_mullo_epi16(_mm_unpacklo_epi8(dst, zero), invLo));
+    __m128i hi = Div255(_mm_mullo_epi16(_mm_unpackhi_epi8(dst, zero), invHi));
+
+    return _mm_adds_epu8(src, _mm_packus_epi16(lo, hi));
+}
+#endif
+
+
+/**
+ * Sample a premultiplied image with bilinear filtering.
+ *
+ * Texels outside the image are transparent.
+ * @param pixels Image pixels
+ * @param wid Image width
+ * @param hit Image height
+ * @param x0 Left texel
+ * @param y0 Top texel
+ * @param fx Weight of the right texels, 0 to 128
+ * @param fy Weight of the bottom texels, 0 to 128
+ * @return Filtered pixel
+ */
+static inline uint32_t Bilinear(const uint32_t *pixels, int wid, int hit, int x0, int y0, int fx, int fy)
+{
+    auto texel = [=](int x, int y) -> uint32_t {
+        return (x < 0 || y < 0 || x >= wid || y >= hit) ? 0 : pixels[size_t(y) * wid + x];
+    };
+
+    uint32_t p00 = texel(x0, y0);
+    uint32_t p10 = texel(x0 + 1, y0);
+    uint32_t p01 = texel(x0, y0 + 1);
+    uint32_t p11 = texel(x0 + 1, y0 + 1);
+
+#ifdef SOFTWARE_RASTERIZER_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    __m128i top = _mm_unpacklo_epi8(_mm_set_epi32(0, 0, int(p10), int(p00)), zero);
+    __m128i bottom = _mm_unpacklo_epi8(_mm_set_epi32(0, 0, int(p11), int(p01)), zero);
+
+    // Down, then across
+    __m128i v = _mm_add_epi16(top, _mm_srai_epi16(
+            _mm_mullo_epi16(_mm_sub_epi16(bottom, top), _mm_set1_epi16(short(fy))), WeightShift));
+    __m128i right = _mm_srli_si128(v, 8);
+    __m128i h = _mm_add_epi16(v, _mm_srai_epi16(
+            _mm_mullo_epi16(_mm_sub_epi16(right, v), _mm_set1_epi16(short(fx))), WeightShift));
+
+    return uint32_t(_mm_cvtsi128_si32(_mm_packus_epi16(h, zero)));
+#else
+    uint32_t result = 0;
+    for (int shift = 0; shift < 32; shift += 8)
+    {
+        int c00 = (p00 >> shift) & 0xff;
+        int c10 = (p10 >> shift) & 0xff;
+        int c01 = (p01 >> shift) & 0xff;
+        int c11 = (p11 >> shift) & 0xff;
+
+        int left = c00 + (((c01 - c00) * fy) >> WeightShift);
+        int right = c10 + (((c11 - c10) * fy) >> WeightShift);
+        int channel = left + (((right - left) * fx) >> WeightShift);
+        result |= uint32_t(std::clamp(channel, 0, 255)) << shift;
+    }
+
+    return result;
+#endif
+}
+
+
+/**
+ * Draw a row of premultiplied pixels over the frame buffer
+ * @param dst Frame buffer pixels
+ * @param src Pixels to draw
+ * @param n Number of pixels
+ */
+static void BlendRow(uint32_t *dst, const uint32_t *src, int n)
+{
+    int i = 0;
+#ifdef SOFTWARE_RASTERIZER_SSE2
+    for ( ; i + 4 <= n; i += 4)
+    {
+        __m128i s = _mm_loadu_si128((const __m128i *)(src + i));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi32(s, _mm_setzero_si128())) == 0xffff)
+        {
+            // All four are transparent
+            continue;
+        }
+
+        __m128i d = _mm_loadu_si128((const __m128i *)(dst + i));
+        _mm_storeu_si128((__m128i *)(dst + i), Over4(s, d));
+    }
+#endif
+
+    for ( ; i < n; i++)
+    {
+        if (src[i] != 0)
+        {
+            dst[i] = Over(src[i], dst[i]);
+        }
+    }
+}
+
+
+/**
+ * Draw a solid color over the frame buffer with per pixel coverage
+ * @param dst Frame buffer pixels
+ * @param color Premultiplied color
+ * @param coverage Coverage of each pixel, 0 to 255
+ * @param n Number of pixels
+ */
+static void BlendSpan(uint32_t *dst, uint32_t color, const uint8_t *coverage, int n)
+{
+    int i = 0;
+#ifdef SOFTWARE_RASTERIZER_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i color16 = _mm_unpacklo_epi8(_mm_set1_epi32(int(color)), zero);
+    for ( ; i + 4 <= n; i += 4)
+    {
+        uint32_t cover;
+        memcpy(&cover, coverage + i, sizeof(cover));
+        if (cover == 0)
+        {
+            continue;
+        }
+
+        __m128i k01 = _mm_set_epi16(coverage[i + 1], coverage[i + 1], coverage[i + 1], coverage[i + 1],
+                coverage[i], coverage[i], coverage[i], coverage[i]);
+        __m128i k23 = _mm_set_epi16(coverage[i + 3], coverage[i + 3], coverage[i + 3], coverage[i + 3],
+                coverage[i + 2], coverage[i + 2], coverage[i + 2], coverage[i + 2]);
+
+        __m128i src = _mm_packus_epi16(Div255(_mm_mullo_epi16(color16, k01)),
+                Div255(_mm_mullo_epi16(color16, k23)));
+        __m128i d = _mm_loadu_si128((const __m128i *)(dst + i));
+        _mm_storeu_si128((__m128i *)(dst + i), Over4(src, d));
+    }
+#endif
+
+    for ( ; i < n; i++)
+    {
+        if (coverage[i] != 0)
+        {
+            dst[i] = Over(ScalePixel(color, coverage[i]), dst[i]);
+        }
+    }
+}
+
+
+/**
+ * Constructor
+ * @param width Frame buffer width in pixels
+ * @param height Frame buffer height in pixels
+ */
+SoftwareRasterizer::SoftwareRasterizer(int width, int height) :
+    mWidth(width), mHeight(height), mPixels(size_t(width) * height, 0)
+{
+}
+
+
+/**
+ * Was the rasterizer built with SIMD blending?
+ * @return true if SSE2 is used
+ */
+bool SoftwareRasterizer::HasSimd()
+{
+#ifdef SOFTWARE_RASTERIZER_SSE2
+    return true;
+#else
+    return false;
+#endif
+}
+
+
+/**
+ * Fill the whole frame buffer and reset the transform and clip
+ * @param color Color to fill with
+ */
+void SoftwareRasterizer::Clear(const wxColour &color)
+{
+    std::fill(mPixels.begin(), mPixels.end(), Premultiply(color, 1));
+    mMatrix = Matrix();
+    mClip = nullptr;
+    mStates.clear();
+}
+
+
+/**
+ * Save the current transform and clip
+ */
+void SoftwareRasterizer::PushState()
+{
+    mStates.push_back(State{mMatrix, mClip});
+}
+
+
+/**
+ * Restore the last saved transform and clip
+ */
+void SoftwareRasterizer::PopState()
+{
+    if (!mStates.empty())
+    {
+        mMatrix = mStates.back().matrix;
+        mClip = mStates.back().clip;
+        mStates.pop_back();
+    }
+}
+
+
+/**
+ * Translate the current transform
+ * @param dx X distance
+ * @param dy Y distance
+ */
+void SoftwareRasterizer::Translate(double dx, double dy)
+{
+    mMatrix.tx += mMatrix.a * dx + mMatrix.c * dy;
+    mMatrix.ty += mMatrix.b * dx + mMatrix.d * dy;
+}
+
+
+/**
+ * Rotate the current transform, clockwise on the screen
+ * @param angle Angle in radians
+ */
+void SoftwareRasterizer::Rotate(double angle)
+{
+    double cs = cos(angle);
+    double sn = sin(angle);
+    Matrix m = mMatrix;
+    mMatrix.a = m.a * cs + m.c * sn;
+    mMatrix.b = m.b * cs + m.d * sn;
+    mMatrix.c = m.c * cs - m.a * sn;
+    mMatrix.d = m.d * cs - m.b * sn;
+}
+
+
+/**
+ * Scale the current transform
+ * @param sx X scale
+ * @param sy Y scale
+ */
+void SoftwareRasterizer::Scale(double sx, double sy)
+{
+    mMatrix.a *= sx;
+    mMatrix.b *= sx;
+    mMatrix.c *= sy;
+    mMatrix.d *= sy;
+}
+
+
+/**
+ * Get the premultiplied copy of an image, converting it
+ * the first time it is drawn
+ * @param image Image to convert
+ * @return Premultiplied sprite
+ */
+const SoftwareRasterizer::Sprite &SoftwareRasterizer::GetSprite(const std::shared_ptr<const wxImage> &image)
+{
+    auto found = mSprites.find(image);
+    if (found != mSprites.end())
+    {
+        return found->second;
+    }
+
+    Sprite &sprite = mSprites[image];
+    sprite.width = image->GetWidth();
+    sprite.height = image->GetHeight();
+    sprite.pixels.resize(size_t(sprite.width) * sprite.height);
+
+    const unsigned char *rgb = image->GetData();
+    const unsigned char *alpha = image->HasAlpha() ? image->GetAlpha() : nullptr;
+    bool mask = image->HasMask();
+    unsigned char mr = image->GetMaskRed(), mg = image->GetMaskGreen(), mb = image->GetMaskBlue();
+
+    for (size_t i = 0; i < sprite.pixels.size(); i++)
+    {
+        uint32_t r = rgb[i * 3], g = rgb[i * 3 + 1], b = rgb[i * 3 + 2];
+        uint32_t a = alpha != nullptr ? alpha[i] : 255;
+        if (mask && r == mr && g == mg && b == mb)
+        {
+            a = 0;
+        }
+
+        sprite.pixels[i] = Pack(Div255(r * a), Div255(g * a), Div255(b * a), a);
+    }
+
+    return sprite;
+}
+
+
+/**
+ * Draw an image under the current transform.
+ *
+ * The image is stretched to the rectangle and filtered
+ * bilinearly, like wxGraphicsContext::DrawBitmap. Only the
+ * part inside the clip is drawn.
+ * @param image Image to draw
+ * @param x Left of the rectangle
+ * @param y Top of the rectangle
+ * @param width Rectangle width
+ * @param height Rectangle height
+ * @param opacity Opacity from 0 to 1
+ */
+void SoftwareRasterizer::DrawImage(const std::shared_ptr<const wxImage> &image, double x, double y,
+        double width, double height, double opacity)
+{
+    if (image == nullptr || !image->IsOk() || width <= 0 || height <= 0)
+    {
+        return;
+    }
+
+    const auto &sprite = GetSprite(image);
+
+    // Texel space to device space
+    double sw = width / sprite.width;
+    double sh = height / sprite.height;
+    double a = mMatrix.a * sw, b = mMatrix.b * sw;
+    double c = mMatrix.c * sh, d = mMatrix.d * sh;
+    double tx = mMatrix.a * x + mMatrix.c * y + mMatrix.tx;
+    double ty = mMatrix.b * x + mMatrix.d * y + mMatrix.ty;
+
+    double det = a * d - b * c;
+    if (fabs(det) < 1e-12)
+    {
+        return;
+    }
+
+    // Device bounds of the rectangle
+    double minX = tx, maxX = tx, minY = ty, maxY = ty;
+    for (auto corner : {wxPoint2DDouble(sprite.width, 0), wxPoint2DDouble(0, sprite.height),
+                        wxPoint2DDouble(sprite.width, sprite.height)})
+    {
+        double px = a * corner.m_x + c * corner.m_y + tx;
+        double py = b * corner.m_x + d * corner.m_y + ty;
+        minX = std::min(minX, px);
+        maxX = std::max(maxX, px);
+        minY = std::min(minY, py);
+        maxY = std::max(maxY, py);
+    }
+
+    int x0 = std::max(0, int(floor(minX)));
+    int x1 = std::min(mWidth, int(ceil(maxX)) + 1);
+    int y0 = std::max(0, int(floor(minY)));
+    int y1 = std::min(mHeight, int(ceil(maxY)) + 1);
+    if (mClip != nullptr)
+    {
+        x0 = std::max(x0, mClip->x0);
+        x1 = std::min(x1, mClip->x1);
+        y0 = std::max(y0, mClip->y0);
+        y1 = std::min(y1, mClip->y1);
+    }
+
+    if (x0 >= x1 || y0 >= y1)
+    {
+        return;
+    }
+
+    uint32_t alpha = uint32_t(lround(std::clamp(opacity, 0.0, 1.0) * 255));
+    mRow.resize(x1 - x0);
+
+    // Device to texel space, stepping one pixel at a time
+    double du = d / det;
+    double dv = -b / det;
+
+    for (int py = y0; py < y1; py++)
+    {
+        double ry = py + 0.5 - ty;
+        double rx = x0 + 0.5 - tx;
+        double u = (d * rx - c * ry) / det - 0.5;
+        double v = (-b * rx + a * ry) / det - 0.5;
+
+        for (int px = x0; px < x1; px++, u += du, v += dv)
+        {
+            uint32_t pixel = 0;
+            if (u > -1 && v > -1 && u < sprite.width && v < sprite.height)
+            {
+                int iu = int(floor(u));
+                int iv = int(floor(v));
+                int fx = int((u - iu) * (1 << WeightShift));
+                int fy = int((v - iv) * (1 << WeightShift));
+                pixel = Bilinear(sprite.pixels.data(), sprite.width, sprite.height, iu, iv, fx, fy);
+                if (alpha < 255)
+                {
+                    pixel = ScalePixel(pixel, alpha);
+                }
+            }
+
+            mRow[px - x0] = pixel;
+        }
+
+        if (mClip != nullptr)
+        {
+            const uint8_t *clip = ClipRow(x0, py);
+            for (int i = 0; i < x1 - x0; i++)
+            {
+                if (clip[i] < 255)
+                {
+                    mRow[i] = ScalePixel(mRow[i], clip[i]);
+                }
+            }
+        }
+
+        BlendRow(&mPixels[size_t(py) * mWidth + x0], mRow.data(), x1 - x0);
+    }
+}
+
+
+/**
+ * Fill a polygon under the current transform.
+ *
+ * Uses the even-odd rule, like wxGraphicsContext::FillPath.
+ * @param points Polygon vertices
+ * @param color Fill color
+ * @param opacity Opacity from 0 to 1
+ */
+void SoftwareRasterizer::FillPolygon(const std::vector<wxPoint2DDouble> &points, const wxColour &color, double opacity)
+{
+    FillDevicePolygon(ToDevice(points), Premultiply(color, opacity));
+}
+
+
+/**
+ * Transform points to device space
+ * @param points Points under the current transform
+ * @return Points in device space
+ */
+std::vector<wxPoint2DDouble> SoftwareRasterizer::ToDevice(const std::vector<wxPoint2DDouble> &points) const
+{
+    std::vector<wxPoint2DDouble> device;
+    device.reserve(points.size());
+    for (auto point : points)
+    {
+        device.push_back(wxPoint2DDouble(mMatrix.a * point.m_x + mMatrix.c * point.m_y + mMatrix.tx,
+                mMatrix.b * point.m_x + mMatrix.d * point.m_y + mMatrix.ty));
+    }
+
+    return device;
+}
+
+
+/**
+ * Get the pixels a device space polygon can touch, limited
+ * to the frame buffer and the clip
+ * @param points Polygon vertices in device space
+ * @param x0 Set to the left pixel
+ * @param y0 Set to the top pixel
+ * @param x1 Set to the right pixel, exclusive
+ * @param y1 Set to the bottom pixel, exclusive
+ * @return false if there are no such pixels
+ */
+bool SoftwareRasterizer::DeviceBounds(const std::vector<wxPoint2DDouble> &points, int &x0, int &y0, int &x1, int &y1) const
+{
+    double minX = points[0].m_x, maxX = minX, minY = points[0].m_y, maxY = minY;
+    for (auto point : points)
+    {
+        minX = std::min(minX, point.m_x);
+        maxX = std::max(maxX, point.m_x);
+        minY = std::min(minY, point.m_y);
+        maxY = std::max(maxY, point.m_y);
+    }
+
+    x0 = std::max(0, int(floor(minX)));
+    x1 = std::min(mWidth, int(ceil(maxX)));
+    y0 = std::max(0, int(floor(minY)));
+    y1 = std::min(mHeight, int(ceil(maxY)));
+    if (mClip != nullptr)
+    {
+        x0 = std::max(x0, mClip->x0);
+        x1 = std::min(x1, mClip->x1);
+        y0 = std::max(y0, mClip->y0);
+        y1 = std::min(y1, mClip->y1);
+    }
+
+    return x0 < x1 && y0 < y1;
+}
+
+
+/**
+ * Compute the coverage of a device space polygon for part of
+ * a pixel row into mCoverageBytes.
+ *
+ * The row is sampled on several scanlines. Spans add their
+ * exact horizontal coverage, so edges are antialiased in
+ * both directions.
+ * @param points Polygon vertices in device space
+ * @param y Row
+ * @param x0 Left pixel
+ * @param x1 Right pixel, exclusive
+ */
+void SoftwareRasterizer::CoverRow(const std::vector<wxPoint2DDouble> &points, int y, int x0, int x1)
+{
+    int n = x1 - x0;
+    mCoverage.assign(n, 0.0f);
+    mCoverageBytes.resize(n);
+
+    // Add coverage for a span of one scanline
+    auto addSpan = [this, x0, x1, n](double left, double right, float weight) {
+        left = std::clamp(left, double(x0), double(x1)) - x0;
+        right = std::clamp(right, double(x0), double(x1)) - x0;
+        int first = int(left);
+        int last = int(right);
+        if (first == last)
+        {
+            if (first < n)
+            {
+                mCoverage[first] += float(right - left) * weight;
+            }
+            return;
+        }
+
+        mCoverage[first] += float(first + 1 - left) * weight;
+        for (int i = first + 1; i < last; i++)
+        {
+            mCoverage[i] += weight;
+        }
+
+        if (last < n)
+        {
+            mCoverage[last] += float(right - last) * weight;
+        }
+    };
+
+    for (int s = 0; s < Subsamples; s++)
+    {
+        double sy = y + (s + 0.5) / Subsamples;
+
+        mCrossings.clear();
+        for (size_t i = 0; i < points.size(); i++)
+        {
+            const auto &p = points[i];
+            const auto &q = points[(i + 1) % points.size()];
+            if ((p.m_y <= sy) != (q.m_y <= sy))
+            {
+                mCrossings.push_back(p.m_x + (sy - p.m_y) * (q.m_x - p.m_x) / (q.m_y - p.m_y));
+            }
+        }
+
+        std::sort(mCrossings.begin(), mCrossings.end());
+        for (size_t i = 0; i + 1 < mCrossings.size(); i += 2)
+        {
+            addSpan(mCrossings[i], mCrossings[i + 1], 1.0f / Subsamples);
+        }
+    }
+
+    for (int i = 0; i < n; i++)
+    {
+        mCoverageBytes[i] = uint8_t(std::min(255.0f, mCoverage[i] * 255 + 0.5f));
+    }
+}
+
+
+/**
+ * Scan convert a polygon in device space
+ * @param points Polygon vertices in device space
+ * @param color Premultiplied fill color
+ */
+void SoftwareRasterizer::FillDevicePolygon(const std::vector<wxPoint2DDouble> &points, uint32_t color)
+{
+    int x0, y0, x1, y1;
+    if (points.size() < 3 || color == 0 || !DeviceBounds(points, x0, y0, x1, y1))
+    {
+        return;
+    }
+
+    int n = x1 - x0;
+    for (int y = y0; y < y1; y++)
+    {
+        CoverRow(points, y, x0, x1);
+
+        if (mClip != nullptr)
+        {
+            const uint8_t *clip = ClipRow(x0, y);
+            for (int i = 0; i < n; i++)
+            {
+                mCoverageBytes[i] = uint8_t(Div255(mCoverageBytes[i] * clip[i]));
+            }
+        }
+
+        BlendSpan(&mPixels[size_t(y) * mWidth + x0], color, mCoverageBytes.data(), n);
+    }
+}
+
+
+/**
+ * Fill an ellipse under the current transform
+ * @param x Left of the bounding rectangle
+ * @param y Top of the bounding rectangle
+ * @param width Ellipse width
+ * @param height Ellipse height
+ * @param color Fill color
+ */
+void SoftwareRasterizer::FillEllipse(double x, double y, double width, double height, const wxColour &color)
+{
+    double rx = width / 2;
+    double ry = height / 2;
+    int steps = std::clamp(int(M_PI * (rx + ry) / 2), 16, 256);
+
+    std::vector<wxPoint2DDouble> points;
+    for (int i = 0; i < steps; i++)
+    {
+        double angle = M_PI * 2 * i / steps;
+        points.push_back(wxPoint2DDouble(x + rx + rx * cos(angle), y + ry + ry * sin(angle)));
+    }
+
+    FillPolygon(points, color);
+}
+
+
+/**
+ * Stroke a line with butt ends under the current transform
+ * @param x1 Start X
+ * @param y1 Start Y
+ * @param x2 End X
+ * @param y2 End Y
+ * @param width Line width
+ * @param color Line color
+ */
+void SoftwareRasterizer::StrokeLine(double x1, double y1, double x2, double y2, double width, const wxColour &color)
+{
+    double dx = x2 - x1;
+    double dy = y2 - y1;
+    double length = sqrt(dx * dx + dy * dy);
+    if (length == 0)
+    {
+        return;
+    }
+
+    // Half width normal to the line
+    double nx = -dy / length * width / 2;
+    double ny = dx / length * width / 2;
+
+    FillPolygon({wxPoint2DDouble(x1 + nx, y1 + ny), wxPoint2DDouble(x2 + nx, y2 + ny),
+                 wxPoint2DDouble(x2 - nx, y2 - ny), wxPoint2DDouble(x1 - nx, y1 - ny)}, color);
+}
+
+
+/**
+ * Stroke the outline of a rectangle under the current
+ * transform, centered on its edges like
+ * wxGraphicsContext::DrawRectangle
+ * @param x Left of the rectangle
+ * @param y Top of the rectangle
+ * @param width Rectangle width
+ * @param height Rectangle height
+ * @param lineWidth Line width
+ * @param color Line color
+ */
+void SoftwareRasterizer::StrokeRectangle(double x, double y, double width, double height,
+        double lineWidth, const wxColour &color)
+{
+    // The top and bottom reach over the corners
+    double h = lineWidth / 2;
+    StrokeLine(x - h, y, x + width + h, y, lineWidth, color);
+    StrokeLine(x - h, y + height, x + width + h, y + height, lineWidth, color);
+    StrokeLine(x, y + h, x, y + height - h, lineWidth, color);
+    StrokeLine(x + width, y + h, x + width, y + height - h, lineWidth, color);
+}
+
+
+/**
+ * Clip drawing to a polygon under the current transform.
+ *
+ * Like wxGraphicsContext::Clip, the new clip is the part of
+ * the polygon inside the current one, and PopState restores
+ * the clip that was saved. The edges are antialiased.
+ * @param points Polygon vertices
+ */
+void SoftwareRasterizer::Clip(const std::vector<wxPoint2DDouble> &points)
+{
+    auto device = ToDevice(points);
+    auto clip = std::make_shared<ClipMask>();
+
+    int x0, y0, x1, y1;
+    if (device.size() >= 3 && DeviceBounds(device, x0, y0, x1, y1))
+    {
+        clip->x0 = x0;
+        clip->y0 = y0;
+        clip->x1 = x1;
+        clip->y1 = y1;
+        clip->coverage.resize(size_t(x1 - x0) * (y1 - y0));
+
+        int n = x1 - x0;
+        for (int y = y0; y < y1; y++)
+        {
+            CoverRow(device, y, x0, x1);
+
+            uint8_t *row = &clip->coverage[size_t(y - y0) * n];
+            const uint8_t *outer = mClip != nullptr ? ClipRow(x0, y) : nullptr;
+            for (int i = 0; i < n; i++)
+            {
+                row[i] = outer != nullptr ? uint8_t(Div255(mCoverageBytes[i] * outer[i])) : mCoverageBytes[i];
+            }
+        }
+    }
+
+    mClip = clip;
+}
+
+
+/**
+ * Get the frame buffer as an image.
+ *
+ * Colors are converted back from premultiplied. The image
+ * has no alpha channel, since frames are drawn on an opaque
+ * background.
+ * @return Image of the frame buffer
+ */
+wxImage SoftwareRasterizer::GetImage() const
+{
+    wxImage image(mWidth, mHeight, false);
+    unsigned char *rgb = image.GetData();
+
+    for (size_t i = 0; i < mPixels.size(); i++)
+    {
+        uint32_t pixel = mPixels[i];
+        uint32_t a = pixel >> 24;
+        for (int k = 0; k < 3; k++)
+        {
+            uint32_t channel = (pixel >> (k * 8)) & 0xff;
+            rgb[i * 3 + k] = (unsigned char)(a == 255 || a == 0 ? channel : std::min(255u, (channel * 255 + a / 2) / a));
+        }
+    }
+
+    return image;
+}
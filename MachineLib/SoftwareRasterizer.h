@@ -0,0 +1,195 @@
+/**
+ * @file SoftwareRasterizer.h
+ * @author Shane Carr
+ *
+ * Draws images and filled polygons directly into a frame buffer.
+ */
+
+#ifndef CANADIANEXPERIENCE_MACHINELIB_SOFTWARERASTERIZER_H
+#define CANADIANEXPERIENCE_MACHINELIB_SOFTWARERASTERIZER_H
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <vector>
+
+/**
+ * Draws images and filled polygons directly into a frame buffer.
+ *
+ * This is a headless alternative to drawing through a
+ * wxGraphicsContext on a memory DC. It only does what our
+ * scenes need: alpha blended image blits under an affine
+ * transform, antialiased solid polygons and clipping to a
+ * polygon. Pixels are kept
+ * as premultiplied RGBA, and blending and filtering use SSE2
+ * where the compiler provides it.
+ *
+ * The transform works like the one in wxGraphicsContext, so
+ * drawing code can be ported one call at a time. Each
+ * rasterizer is used by one thread.
+ */
+class SoftwareRasterizer {
+public:
+    /// An affine transform, x' = a x + c y + tx, y' = b x + d y + ty
+    struct Matrix
+    {
+        double a = 1;   ///< X scale and rotation
+        double b = 0;   ///< Y shear and rotation
+        double c = 0;   ///< X shear and rotation
+        double d = 1;   ///< Y scale and rotation
+        double tx = 0;  ///< X translation
+        double ty = 0;  ///< Y translation
+    };
+
+private:
+    /// An image converted to premultiplied pixels
+    struct Sprite
+    {
+        /// Image width
+        int width = 0;
+
+        /// Image height
+        int height = 0;
+
+        /// Premultiplied pixels
+        std::vector<uint32_t> pixels;
+    };
+
+    /// An antialiased clip mask over a rectangle of the frame buffer
+    struct ClipMask
+    {
+        int x0 = 0;     ///< Left of the rectangle
+        int y0 = 0;     ///< Top of the rectangle
+        int x1 = 0;     ///< Right of the rectangle, exclusive
+        int y1 = 0;     ///< Bottom of the rectangle, exclusive
+
+        /// Coverage of each pixel in the rectangle, 0 to 255
+        std::vector<uint8_t> coverage;
+    };
+
+    /// A saved transform and clip
+    struct State
+    {
+        /// Transform
+        Matrix matrix;
+
+        /// Clip, null if none
+        std::shared_ptr<const ClipMask> clip;
+    };
+
+    /// Frame buffer width
+    int mWidth;
+
+    /// Frame buffer height
+    int mHeight;
+
+    /// Premultiplied RGBA pixels, row by row
+    std::vector<uint32_t> mPixels;
+
+    /// The current transform
+    Matrix mMatrix;
+
+    /// The current clip, null if nothing is clipped. Masks
+    /// are never changed once made, so states share them.
+    std::shared_ptr<const ClipMask> mClip;
+
+    /// Saved transforms and clips
+    std::vector<State> mStates;
+
+    /// Images we have converted, kept alive while we use them
+    std::map<std::shared_ptr<const wxImage>, Sprite> mSprites;
+
+    /// Coverage for one row while filling a polygon
+    std::vector<float> mCoverage;
+
+    /// Coverage as bytes for one row
+    std::vector<uint8_t> mCoverageBytes;
+
+    /// Where the polygon edges cross a scanline
+    std::vector<double> mCrossings;
+
+    /// Sampled image pixels for one row
+    std::vector<uint32_t> mRow;
+
+    const Sprite &GetSprite(const std::shared_ptr<const wxImage> &image);
+    std::vector<wxPoint2DDouble> ToDevice(const std::vector<wxPoint2DDouble> &points) const;
+    bool DeviceBounds(const std::vector<wxPoint2DDouble> &points, int &x0, int &y0, int &x1, int &y1) const;
+    void CoverRow(const std::vector<wxPoint2DDouble> &points, int y, int x0, int x1);
+
+    /**
+     * Get the clip coverage for part of a row. The part must
+     * be inside the clip rectangle.
+     * @param x X location of the first pixel
+     * @param y Y location of the row
+     * @return Coverage of the pixels from x on
+     */
+    const uint8_t *ClipRow(int x, int y) const
+    {
+        return &mClip->coverage[size_t(y - mClip->y0) * (mClip->x1 - mClip->x0) + (x - mClip->x0)];
+    }
+
+    void FillDevicePolygon(const std::vector<wxPoint2DDouble> &points, uint32_t color);
+
+public:
+    SoftwareRasterizer(int width, int height);
+
+    /// Copy constructor (disabled)
+    SoftwareRasterizer(const SoftwareRasterizer &) = delete;
+
+    /// Assignment operator (disabled)
+    void operator=(const SoftwareRasterizer &) = delete;
+
+    void Clear(const wxColour &color);
+
+    void PushState();
+    void PopState();
+    void Translate(double dx, double dy);
+    void Rotate(double angle);
+    void Scale(double sx, double sy);
+
+    /**
+     * Get the current transform
+     * @return Transform matrix
+     */
+    const Matrix &GetTransform() const { return mMatrix; }
+
+    void DrawImage(const std::shared_ptr<const wxImage> &image, double x, double y,
+            double width, double height, double opacity = 1);
+    void FillPolygon(const std::vector<wxPoint2DDouble> &points, const wxColour &color, double opacity = 1);
+    void FillEllipse(double x, double y, double width, double height, const wxColour &color);
+    void StrokeLine(double x1, double y1, double x2, double y2, double width, const wxColour &color);
+    void StrokeRectangle(double x, double y, double width, double height, double lineWidth, const wxColour &color);
+
+    void Clip(const std::vector<wxPoint2DDouble> &points);
+
+    /**
+     * Stop clipping
+     */
+    void ResetClip() { mClip = nullptr; }
+
+    wxImage GetImage() const;
+
+    /**
+     * Get a premultiplied pixel
+     * @param x X location
+     * @param y Y location
+     * @return Pixel as bytes R, G, B, A in memory order
+     */
+    uint32_t GetPixel(int x, int y) const { return mPixels[size_t(y) * mWidth + x]; }
+
+    /**
+     * Get the frame buffer width
+     * @return Width in pixels
+     */
+    int GetWidth() const { return mWidth; }
+
+    /**
+     * Get the frame buffer height
+     * @return Height in pixels
+     */
+    int GetHeight() const { return mHeight; }
+
+    static bool HasSimd();
+};
+
+#endif //CANADIANEXPERIENCE_MACHINELIB_SOFTWARERASTERIZER_H
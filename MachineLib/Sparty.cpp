@@ -6,6 +6,17 @@
 #include "pch.h"
 #include "Sparty.h"
 #include "Component.h"
+#include "LevelOfDetail.h"
+#include "SoftwareRasterizer.h"
+
+/// Horizontal bounce amplitude when Sparty is fully popped up
+const double InitialHorizontalBounce = 20;
+
+/// Vertical bounce amplitude when Sparty is fully popped up
+const double InitialVerticalBounce = 30;
+
+/// Straight lines each spring curve is drawn with when rasterizing
+const int SpringCurveSegments = 8;
 
 /**
  * Constructor for Sparty.
@@ -22,19 +33,21 @@
 Sparty::Sparty(const std::wstring& imagePath, int size, double springLength,
                double springWidth, int numLinks) :
     mImagePath(imagePath), mSize(size), mSpringWidth(springWidth),
-    mNumLinks(numLinks)
+    mNumLinks(numLinks), mSpringLength(springLength)
 {
+    InitState<SpartyState>();
+
     // Initially compressed
     mCompressedLength = springLength * 0.2;  // 20% of full length
-    mSpringLength = springLength;  // Store the full spring length
 
     // Create the polygon for Sparty
     mSparty.Rectangle(-size/2, mCompressedLength / 2, size, size);
     mSparty.SetImage(imagePath);
 
     // Initialize at compressed state
-    mPopupAngle = 0;
-    mSpringLength = mCompressedLength;
+    auto &state = GetState<SpartyState>();
+    state.popupAngle = 0;
+    state.springLength = mCompressedLength;
 }
 
 /**
@@ -47,6 +60,8 @@ Sparty::Sparty(const std::wstring& imagePath, int size, double springLength,
  */
 void Sparty::Draw(std::shared_ptr<wxGraphicsContext> graphics)
 {
+    const auto &state = GetState<SpartyState>();
+
     graphics->PushState();
 
     // Set up spring drawing
@@ -54,15 +69,15 @@ void Sparty::Draw(std::shared_ptr<wxGraphicsContext> graphics)
     graphics->SetPen(springPen);
 
     // Draw spring at base position
-    DrawSpring(graphics, GetX(), GetY(), mSpringLength, mSpringWidth, mNumLinks);
+    DrawSpring(graphics, GetX(), GetY(), state.springLength, mSpringWidth, mNumLinks);
 
     // Draw Sparty with bounce
-    double s = sin(mPopupAngle);
-    double height = mCompressedLength + s * (mSpringLength - mCompressedLength);
+    double s = sin(state.popupAngle);
+    double height = mCompressedLength + s * (state.springLength - mCompressedLength);
 
     // Add bouncing motion
-    double bounceX = mHorizontalBounce * sin(GetTime() * mBounceFrequency);
-    double bounceY = mVerticalBounce * cos(GetTime() * mBounceFrequency);
+    double bounceX = state.horizontalBounce * sin(GetTime() * mBounceFrequency);
+    double bounceY = state.verticalBounce * cos(GetTime() * mBounceFrequency);
 
     graphics->PushState();
     graphics->Translate(GetX() + bounceX, GetY() - height + bounceY);
@@ -93,7 +108,7 @@ void Sparty::Update(double elapsed)
  */
 void Sparty::KeyFall()
 {
-    mPopped = true;  // Set flag to trigger animation
+    GetState<SpartyState>().popped = true;  // Set flag to trigger animation
 }
 
 /**
@@ -112,11 +127,45 @@ void Sparty::KeyFall()
 void Sparty::DrawSpring(std::shared_ptr<wxGraphicsContext> graphics,
                         int x, int y, double length, double width, int numLinks)
 {
+    // Fewer, longer links when the spring is small on screen. Based
+    // on the full length, so the count doesn't change as it extends
+    numLinks = LevelOfDetail::Get().SpringLinks(numLinks, mSpringLength, LevelOfDetail::Scale(graphics));
+
+    auto points = SpringCurves(x, y, length, width, numLinks);
+
     auto path = graphics->CreatePath();
+    path.MoveToPoint(points[0].m_x, points[0].m_y);
+    for(size_t i = 1; i + 2 < points.size(); i += 3)
+    {
+        path.AddCurveToPoint(points[i].m_x, points[i].m_y,
+                             points[i + 1].m_x, points[i + 1].m_y,
+                             points[i + 2].m_x, points[i + 2].m_y);
+    }
 
+    graphics->StrokePath(path);
+}
+
+
+/**
+ * Compute the curves that make up the spring.
+ *
+ * Each link is a curve up the right side and a curve up the
+ * left side. Links near the top bounce more.
+ *
+ * @param x X-coordinate for the starting point of the spring.
+ * @param y Y-coordinate for the starting point of the spring.
+ * @param length Length of the spring.
+ * @param width Width of the spring.
+ * @param numLinks Number of links in the spring.
+ * @return The start point, then two control points and an end
+ * point for each curve
+ */
+std::vector<wxPoint2DDouble> Sparty::SpringCurves(int x, int y, double length, double width, int numLinks)
+{
     // Calculate bounce offsets
-    double bounceX = mHorizontalBounce * sin(GetTime() * mBounceFrequency);
-    double bounceY = mVerticalBounce * cos(GetTime() * mBounceFrequency);
+    const auto &state = GetState<SpartyState>();
+    double bounceX = state.horizontalBounce * sin(GetTime() * mBounceFrequency);
+    double bounceY = state.verticalBounce * cos(GetTime() * mBounceFrequency);
 
     // Start at bottom (fixed point)
     double y1 = y;
@@ -126,7 +175,8 @@ void Sparty::DrawSpring(std::shared_ptr<wxGraphicsContext> graphics,
     double xR = x + width / 2;
     double xL = x - width / 2;
 
-    path.MoveToPoint(x, y1);
+    std::vector<wxPoint2DDouble> points;
+    points.push_back(wxPoint2DDouble(x, y1));
 
     // Draw each link with progressively more bounce effect
     for(int i = 0; i < numLinks; i++)
@@ -140,18 +190,63 @@ void Sparty::DrawSpring(std::shared_ptr<wxGraphicsContext> graphics,
         auto y3 = y2 - linkLength / 2;
 
         // Add bounce to control points
-        path.AddCurveToPoint(xR + currentBounceX, y1,
-                             xR + currentBounceX, y3 + currentBounceY,
-                             x + currentBounceX, y3 + currentBounceY);
+        points.push_back(wxPoint2DDouble(xR + currentBounceX, y1));
+        points.push_back(wxPoint2DDouble(xR + currentBounceX, y3 + currentBounceY));
+        points.push_back(wxPoint2DDouble(x + currentBounceX, y3 + currentBounceY));
 
-        path.AddCurveToPoint(xL + currentBounceX, y3 + currentBounceY,
-                             xL + currentBounceX, y2 + currentBounceY,
-                             x + currentBounceX, y2 + currentBounceY);
+        points.push_back(wxPoint2DDouble(xL + currentBounceX, y3 + currentBounceY));
+        points.push_back(wxPoint2DDouble(xL + currentBounceX, y2 + currentBounceY));
+        points.push_back(wxPoint2DDouble(x + currentBounceX, y2 + currentBounceY));
 
         y1 = y2;
     }
 
-    graphics->StrokePath(path);
+    return points;
+}
+
+
+/**
+ * Draw Sparty and the spring with the software rasterizer.
+ *
+ * The same as Draw, except the spring curves are drawn as
+ * short straight lines.
+ *
+ * @param rasterizer Rasterizer to draw into.
+ */
+void Sparty::Rasterize(SoftwareRasterizer &rasterizer)
+{
+    const auto &state = GetState<SpartyState>();
+
+    int numLinks = LevelOfDetail::Get().SpringLinks(mNumLinks, mSpringLength, LevelOfDetail::Scale(rasterizer));
+    auto points = SpringCurves(GetX(), GetY(), state.springLength, mSpringWidth, numLinks);
+
+    auto previous = points[0];
+    for(size_t i = 1; i + 2 < points.size(); i += 3)
+    {
+        auto p0 = points[i - 1], c1 = points[i], c2 = points[i + 1], p1 = points[i + 2];
+        for(int step = 1; step <= SpringCurveSegments; step++)
+        {
+            double t = double(step) / SpringCurveSegments;
+            double u = 1 - t;
+            double k0 = u * u * u, k1 = 3 * u * u * t, k2 = 3 * u * t * t, k3 = t * t * t;
+            wxPoint2DDouble point(k0 * p0.m_x + k1 * c1.m_x + k2 * c2.m_x + k3 * p1.m_x,
+                                  k0 * p0.m_y + k1 * c1.m_y + k2 * c2.m_y + k3 * p1.m_y);
+            rasterizer.StrokeLine(previous.m_x, previous.m_y, point.m_x, point.m_y, SpringWireSize, SpringColor);
+            previous = point;
+        }
+    }
+
+    // Draw Sparty with bounce
+    double s = sin(state.popupAngle);
+    double height = mCompressedLength + s * (state.springLength - mCompressedLength);
+
+    double bounceX = state.horizontalBounce * sin(GetTime() * mBounceFrequency);
+    double bounceY = state.verticalBounce * cos(GetTime() * mBounceFrequency);
+
+    rasterizer.PushState();
+    rasterizer.Translate(GetX() + bounceX, GetY() - height + bounceY);
+    mSparty.Rasterize(rasterizer, 0, 0);
+    rasterizer.PopState();
 }
 
 
@@ -165,34 +260,65 @@ void Sparty::DrawSpring(std::shared_ptr<wxGraphicsContext> graphics,
  */
 void Sparty::Advance(double delta)
 {
-        Component::Advance(delta);
+    FastForward(1, delta, GetTime() + delta);
+}
 
-        double openAngle = M_PI / 2;
 
-        if(mPopped && mPopupAngle < openAngle)
-        {
-            mPopupAngle += openAngle * delta / SpartyPopupTime;
-
-            if(mPopupAngle > openAngle)
-            {
-                mPopupAngle = openAngle;
-                // Start bounce when fully extended
-                mHorizontalBounce = 20;  // Initial horizontal amplitude
-                mVerticalBounce = 30;    // Initial vertical amplitude
-            }
-
-            double s = sin(mPopupAngle);
-            mSpringLength = mCompressedLength + s * (260 - mCompressedLength);
-        }
+/**
+ * Advance Sparty a number of frames at once.
+ *
+ * Sparty pops up at a constant rate, and once fully up the
+ * bounce decays by the same factor every frame. Both follow
+ * from the number of frames since the key fell, so the state
+ * is computed from that count directly. Advance comes through
+ * here too, so a jump gives exactly what stepping gives.
+ *
+ * @param frames Number of frames to advance
+ * @param delta Frame time in seconds
+ * @param time Machine time at the end of the last frame
+ */
+void Sparty::FastForward(int frames, double delta, double time)
+{
+    SetTime(time);
 
-        // Apply bounce if popped up
-        if(mPopupAngle >= openAngle)
-        {
+    auto &state = GetState<SpartyState>();
+    if(!state.popped)
+    {
+        return;
+    }
 
-            // Decay the bounce amplitudes
-            mHorizontalBounce *= mBounceDecay;
-            mVerticalBounce *= mBounceDecay;
-        }
+    state.popFrames += frames;
+
+    double openAngle = M_PI / 2;
+    auto angle = [=, this](int n) { return openAngle * (n * delta) / SpartyPopupTime; };
+
+    state.popupAngle = std::min(openAngle, angle(state.popFrames));
+
+    double s = sin(state.popupAngle);
+    state.springLength = mCompressedLength + s * (260 - mCompressedLength);
+
+    if(state.popupAngle < openAngle)
+    {
+        return;
+    }
+
+    // First frame Sparty was fully up. The estimate can be a
+    // frame off from rounding, so settle it with the same test
+    int upFrame = std::clamp(int(std::ceil(SpartyPopupTime / delta)), 1, state.popFrames);
+    while(upFrame > 1 && angle(upFrame - 1) >= openAngle)
+    {
+        upFrame--;
+    }
+
+    while(angle(upFrame) < openAngle)
+    {
+        upFrame++;
+    }
+
+    // The bounce starts when fully extended and decays every frame from then on
+    double decay = std::pow(mBounceDecay, state.popFrames - upFrame + 1);
+    state.horizontalBounce = InitialHorizontalBounce * decay;
+    state.verticalBounce = InitialVerticalBounce * decay;
 }
 
 /**
@@ -204,9 +330,13 @@ void Sparty::Advance(double delta)
 void Sparty::Reset()
 {
     Component::Reset();
-    mPopupAngle = 0;
-    mPopped = false;
-    mSpringLength = mCompressedLength;
-    mHorizontalBounce = 0;
-    mVerticalBounce = 0;
-}
\ No newline at end of file
+
+    auto &state = GetState<SpartyState>();
+    state.popupAngle = 0;
+    state.popped = false;
+    state.popFrames = 0;
+    state.springLength = mCompressedLength;
+    state.horizontalBounce = 0;
+    state.verticalBounce = 0;
+}
+
@@ -23,6 +23,17 @@
 class Sparty : public Component, public IKeyFall
 {
 private:
+    /// Simulation state of Sparty
+    struct SpartyState : ComponentState
+    {
+        double springLength = 0;      ///< Current spring length
+        double popupAngle = 0;        ///< Current angle (for animation)
+        bool popped = false;          ///< Flag for whether Sparty is popped or not
+        int popFrames = 0;            ///< Frames since Sparty popped
+        double horizontalBounce = 0;  ///< Current horizontal offset
+        double verticalBounce = 0;    ///< Additional vertical bounce
+    };
+
     /// The Sparty polygon used to draw the character
     cse335::Polygon mSparty;
 
@@ -45,23 +56,17 @@ private:
     const double SpartyPopupTime = 0.25;
 
     /// Spring parameters
-    double mSpringLength = 0;      ///< Current spring length
     double mSpringWidth = 0;       ///< Spring width
     int mNumLinks = 0;            ///< Number of spring links
+    double mSpringLength = 0;      ///< Length when fully extended
     double mCompressedLength = 0;  ///< Length when compressed
 
-    /// Current angle (for animation)
-    double mPopupAngle = 0;
-
-    /// Flag for whether Sparty is popped or not
-    bool mPopped = false;
-
     /// Bounce parameters
-    double mHorizontalBounce = 0;    /// Current horizontal offset
-    double mVerticalBounce = 0;      /// Additional vertical bounce
     double mBounceDecay = 0.95;      /// How quickly bounce dies out
     double mBounceFrequency = 15;    /// Speed of bounce
 
+    std::vector<wxPoint2DDouble> SpringCurves(int x, int y, double length, double width, int numLinks);
+
 public:
     /**
      * Constructor to create a Sparty component.
@@ -95,15 +100,36 @@ public:
      */
     void DrawForeground(std::shared_ptr<wxGraphicsContext> graphics) override { }
 
+    /**
+     * Draw Sparty and the spring with the software rasterizer.
+     * @param rasterizer Rasterizer to draw into.
+     */
+    void Rasterize(SoftwareRasterizer &rasterizer) override;
+
+    /**
+     * Draw the foreground elements of Sparty with the software rasterizer (there are none).
+     * @param rasterizer Rasterizer to draw into.
+     */
+    void RasterizeForeground(SoftwareRasterizer &rasterizer) override { }
+
     /**
      * Advance Sparty's state over time.
      */
     void Advance(double delta)override;
 
+    /**
+     * Advance Sparty a number of frames at once.
+     * @param frames Number of frames to advance
+     * @param delta Frame time in seconds
+     * @param time Machine time at the end of the last frame
+     */
+    void FastForward(int frames, double delta, double time) override;
+
     /**
      * Reset Sparty to its initial state.
      */
     void Reset() override;
+
 };
 
 #endif //CANADIANEXPERIENCE_MACHINELIB_SPARTY_H
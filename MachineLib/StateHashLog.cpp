@@ -0,0 +1,159 @@
+/**
+ * @file StateHashLog.cpp
+ * @author Shane Carr
+ */
+
+#include "pch.h"
+#include <istream>
+#include <ostream>
+
+#include "StateHashLog.h"
+#include "MachineSystem.h"
+#include "Machine.h"
+
+/// Tag at the start of a saved log
+const char LogMagic[4] = {'M', 'S', 'H', 'L'};
+
+/// Version of the saved log format
+const uint32_t LogVersion = 1;
+
+/**
+ * Write a value in its in-memory form
+ * @param out Stream to write to
+ * @param value Value to write
+ */
+template <class T>
+static void Write(std::ostream &out, const T &value)
+{
+    out.write(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+/**
+ * Read a value written by Write
+ * @param in Stream to read from
+ * @param value Value to read into
+ * @return true if it was read
+ */
+template <class T>
+static bool Read(std::istream &in, T &value)
+{
+    return bool(in.read(reinterpret_cast<char *>(&value), sizeof(T)));
+}
+
+
+/**
+ * Constructor
+ * @param machineNumber Machine the log is for
+ * @param frameRate Frame rate the machine runs at
+ */
+StateHashLog::StateHashLog(int machineNumber, double frameRate) :
+    mMachineNumber(machineNumber), mFrameRate(frameRate)
+{
+}
+
+
+/**
+ * Save the log.
+ *
+ * Each entry takes 12 bytes: the frame as 32 bits and the
+ * hash as 64. Values are written in the machine's byte order.
+ * @param out Binary stream to save to
+ * @return true if written
+ */
+bool StateHashLog::Save(std::ostream &out) const
+{
+    out.write(LogMagic, sizeof(LogMagic));
+    Write(out, LogVersion);
+    Write(out, int32_t(mMachineNumber));
+    Write(out, mFrameRate);
+    Write(out, uint64_t(mEntries.size()));
+
+    for (const auto &entry : mEntries)
+    {
+        Write(out, int32_t(entry.frame));
+        Write(out, entry.hash);
+    }
+
+    return bool(out);
+}
+
+
+/**
+ * Load a saved log
+ * @param in Binary stream to load from
+ * @return The log, or null if the stream does not hold one
+ */
+std::shared_ptr<StateHashLog> StateHashLog::Load(std::istream &in)
+{
+    char magic[sizeof(LogMagic)];
+    uint32_t version;
+    int32_t machineNumber;
+    double frameRate;
+    uint64_t count;
+
+    if (!in.read(magic, sizeof(magic)) || !std::equal(magic, magic + sizeof(magic), LogMagic) ||
+        !Read(in, version) || version != LogVersion ||
+        !Read(in, machineNumber) || !Read(in, frameRate) || !Read(in, count))
+    {
+        return nullptr;
+    }
+
+    auto log = std::make_shared<StateHashLog>(machineNumber, frameRate);
+    for (uint64_t i = 0; i < count; i++)
+    {
+        int32_t frame;
+        uint64_t hash;
+        if (!Read(in, frame) || !Read(in, hash))
+        {
+            return nullptr;
+        }
+
+        log->Add(frame, hash);
+    }
+
+    return log;
+}
+
+
+/**
+ * Replay the machine and find the first entry that does not
+ * match it.
+ *
+ * The replay steps every frame in order from the start, with
+ * no fast forwarding and no checkpoints.
+ * @param resourcesDir Directory containing the machine resources
+ * @return Frame of the first entry that diverges, NoDivergence if none
+ */
+int StateHashLog::FindDivergence(const std::wstring &resourcesDir) const
+{
+    int last = 0;
+    for (const auto &entry : mEntries)
+    {
+        last = std::max(last, entry.frame);
+    }
+
+    MachineSystem replay(resourcesDir);
+    replay.SetFrameRate(mFrameRate);
+    replay.ChooseMachine(mMachineNumber);
+    replay.SetCheckpointInterval(0);
+    replay.SetFastForward(false);
+    replay.StartHashLog();
+    replay.SetMachineFrame(last);
+
+    // The replay visits every frame once, in order
+    std::vector<uint64_t> hashes(last + 1);
+    for (const auto &entry : replay.GetHashLog()->GetEntries())
+    {
+        hashes[entry.frame] = entry.hash;
+    }
+
+    for (const auto &entry : mEntries)
+    {
+        if (entry.frame < 0 || hashes[entry.frame] != entry.hash)
+        {
+            return entry.frame;
+        }
+    }
+
+    return NoDivergence;
+}
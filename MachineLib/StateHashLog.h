@@ -0,0 +1,93 @@
+/**
+ * @file StateHashLog.h
+ * @author Shane Carr
+ *
+ * A log of machine state hashes, one per frame visited.
+ */
+
+#ifndef CANADIANEXPERIENCE_MACHINELIB_STATEHASHLOG_H
+#define CANADIANEXPERIENCE_MACHINELIB_STATEHASHLOG_H
+
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * A log of machine state hashes, one per frame visited.
+ *
+ * A MachineSystem logging hashes adds an entry for every
+ * frame it lands on, however it got there: stepping, fast
+ * forwarding or restoring a checkpoint. FindDivergence replays
+ * the machine by plain sequential stepping and reports the first
+ * entry whose hash does not match, which is how seek shortcuts
+ * and simulator changes are checked against the simple way.
+ */
+class StateHashLog
+{
+public:
+    /// The state hash at one frame
+    struct Entry
+    {
+        /// Frame number
+        int frame = 0;
+
+        /// Hash of the machine state at that frame
+        uint64_t hash = 0;
+    };
+
+    /// FindDivergence result when every entry matches
+    static const int NoDivergence = -1;
+
+private:
+    /// Machine the log is for
+    int mMachineNumber = 1;
+
+    /// Frame rate the machine ran at
+    double mFrameRate = 30;
+
+    /// Entries in the order the frames were visited
+    std::vector<Entry> mEntries;
+
+public:
+    StateHashLog(int machineNumber, double frameRate);
+
+    /// Copy constructor (disabled)
+    StateHashLog(const StateHashLog &) = delete;
+
+    /// Assignment operator (disabled)
+    void operator=(const StateHashLog &) = delete;
+
+    /**
+     * Add the hash of a frame
+     * @param frame Frame number
+     * @param hash Hash of the machine state
+     */
+    void Add(int frame, uint64_t hash) { mEntries.push_back({frame, hash}); }
+
+    /**
+     * Get the entries
+     * @return Entries in the order the frames were visited
+     */
+    const std::vector<Entry> &GetEntries() const { return mEntries; }
+
+    /**
+     * Get the machine the log is for
+     * @return Machine number
+     */
+    int GetMachineNumber() const { return mMachineNumber; }
+
+    /**
+     * Get the frame rate the machine ran at
+     * @return Frames per second
+     */
+    double GetFrameRate() const { return mFrameRate; }
+
+    bool Save(std::ostream &out) const;
+    static std::shared_ptr<StateHashLog> Load(std::istream &in);
+
+    int FindDivergence(const std::wstring &resourcesDir) const;
+};
+
+#endif //CANADIANEXPERIENCE_MACHINELIB_STATEHASHLOG_H
@@ -0,0 +1,16 @@
+/**
+ * @file image-cache.h
+ * @author Shane Carr
+ *
+ * Header for the shared image cache in the machines library.
+ *
+ * The cache is shared by the machines and the application,
+ * so identical images are only decoded once per process.
+ */
+
+#ifndef MACHINELIB_IMAGE_CACHE_H
+#define MACHINELIB_IMAGE_CACHE_H
+
+#include "../ImageCache.h"
+
+#endif //MACHINELIB_IMAGE_CACHE_H
@@ -0,0 +1,13 @@
+/**
+ * @file machine-seek.h
+ * @author Shane Carr
+ *
+ * Header for the seek cost interface of the machine system.
+ */
+
+#ifndef MACHINELIB_MACHINE_SEEK_H
+#define MACHINELIB_MACHINE_SEEK_H
+
+#include "../IMachineSeek.h"
+
+#endif //MACHINELIB_MACHINE_SEEK_H
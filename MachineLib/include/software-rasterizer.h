@@ -0,0 +1,18 @@
+/**
+ * @file software-rasterizer.h
+ * @author Shane Carr
+ *
+ * Header for the software rasterizer in the machines library.
+ *
+ * The application uses the rasterizer to render its actors
+ * headless. Machine systems that implement IMachineRasterizer
+ * draw their machines with it as well.
+ */
+
+#ifndef MACHINELIB_SOFTWARE_RASTERIZER_H
+#define MACHINELIB_SOFTWARE_RASTERIZER_H
+
+#include "../SoftwareRasterizer.h"
+#include "../IMachineRasterizer.h"
+
+#endif //MACHINELIB_SOFTWARE_RASTERIZER_H
@@ -0,0 +1,32 @@
+/**
+ * @file ComponentGroupsTest.cpp
+ * @author Shane Carr
+ */
+
+#include "pch.h"
+#include "gtest/gtest.h"
+
+#include <MachineSystem.h>
+#include <Machine.h>
+
+TEST(ComponentGroupsTest, SameAsVirtual)
+{
+    MachineSystem grouped(L".");
+    MachineSystem virtuals(L".");
+    ASSERT_TRUE(grouped.GetMachine()->GetDefinition()->GetGroups().IsGrouped());
+    virtuals.GetMachine()->SetGrouped(false);
+
+    for (auto system : {&grouped, &virtuals})
+    {
+        system->SetCheckpointInterval(0);
+        system->SetFastForward(false);
+    }
+
+    // Across the key fall and the box and Sparty opening
+    for (int frame = 1; frame <= 600; frame++)
+    {
+        grouped.SetMachineFrame(frame);
+        virtuals.SetMachineFrame(frame);
+        ASSERT_EQ(grouped.GetMachine()->GetState().Hash(), virtuals.GetMachine()->GetState().Hash()) << frame;
+    }
+}
@@ -0,0 +1,85 @@
+/**
+ * @file ImageCacheTest.cpp
+ * @author Shane Carr
+ */
+
+#include "pch.h"
+#include "gtest/gtest.h"
+
+#include <ImageCache.h>
+
+TEST(ImageCacheTest, Sharing)
+{
+    auto &cache = ImageCache::Get();
+    auto hits = cache.GetHits();
+    auto misses = cache.GetMisses();
+    auto saved = cache.GetBytesSaved();
+
+    auto lid1 = cache.Load(L"images/box-lid.png");
+    ASSERT_TRUE(lid1->IsOk());
+
+    // Same path
+    auto lid2 = cache.Load(L"images/box-lid.png");
+    ASSERT_EQ(lid1, lid2);
+
+    // Same file through a different path is the same content
+    auto lid3 = cache.Load(L"./images/box-lid.png");
+    ASSERT_EQ(lid1, lid3);
+
+    ASSERT_EQ(misses + 1, cache.GetMisses());
+    ASSERT_EQ(hits + 2, cache.GetHits());
+    ASSERT_GT(cache.GetBytesSaved(), saved);
+
+    // Different file is a different image
+    auto key = cache.Load(L"images/key.png");
+    ASSERT_NE(lid1, key);
+
+    // Missing files are not ok and not cached
+    auto missing = cache.Load(L"images/no-such-file.png");
+    ASSERT_NE(nullptr, missing);
+    ASSERT_FALSE(missing->IsOk());
+}
+
+TEST(ImageCacheTest, Eviction)
+{
+    auto &cache = ImageCache::Get();
+
+    std::weak_ptr<const wxImage> weak;
+    {
+        auto flag = cache.Load(L"images/flag.png");
+        weak = flag;
+        ASSERT_FALSE(weak.expired());
+    }
+
+    // The cache does not keep the image alive
+    ASSERT_TRUE(weak.expired());
+
+    auto misses = cache.GetMisses();
+    auto flag = cache.Load(L"images/flag.png");
+    ASSERT_TRUE(flag->IsOk());
+    ASSERT_EQ(misses + 1, cache.GetMisses());
+}
+
+TEST(ImageCacheTest, Clear)
+{
+    auto &cache = ImageCache::Get();
+
+    wxBitmap bitmap(100, 100);
+    wxMemoryDC dc(bitmap);
+    auto graphics = std::shared_ptr<wxGraphicsContext>(wxGraphicsContext::Create( dc ));
+
+    auto lid = cache.Load(L"images/box-lid.png");
+    auto hits = cache.GetBitmapHits();
+    cache.GetBitmap(graphics, lid);
+    cache.GetBitmap(graphics, lid);
+    ASSERT_EQ(hits + 1, cache.GetBitmapHits());
+
+    // Clearing drops the bitmaps but keeps the image in use
+    cache.Clear();
+    auto misses = cache.GetMisses();
+    ASSERT_EQ(lid, cache.Load(L"images/box-lid.png"));
+    ASSERT_EQ(misses, cache.GetMisses());
+
+    cache.GetBitmap(graphics, lid);
+    ASSERT_EQ(hits + 1, cache.GetBitmapHits());
+}
@@ -0,0 +1,33 @@
+/**
+ * @file LevelOfDetailTest.cpp
+ * @author Shane Carr
+ */
+
+#include "pch.h"
+#include "gtest/gtest.h"
+
+#include <LevelOfDetail.h>
+
+TEST(LevelOfDetailTest, Reduction)
+{
+    auto &lod = LevelOfDetail::Get();
+
+    // Full size keeps everything
+    ASSERT_EQ(20, lod.CylinderLines(20, 50, 1));
+    ASSERT_EQ(10, lod.SpringLinks(10, 200, 1));
+    ASSERT_EQ(32, lod.CircleSteps(32, 100, 1));
+
+    // A tenth of the size loses detail
+    ASSERT_EQ(6, lod.CylinderLines(20, 50, 0.2));
+    ASSERT_EQ(0, lod.CylinderLines(20, 50, 0.05));
+    ASSERT_LT(lod.SpringLinks(10, 200, 0.1), 10);
+    ASSERT_LE(1, lod.SpringLinks(10, 200, 0.001));
+    ASSERT_LT(lod.CircleSteps(32, 100, 0.1), 32);
+    ASSERT_EQ(8, lod.CircleSteps(32, 100, 0.001));
+
+    // Disabled always gives full detail
+    lod.SetEnabled(false);
+    ASSERT_EQ(20, lod.CylinderLines(20, 50, 0.05));
+    ASSERT_EQ(32, lod.CircleSteps(32, 100, 0.001));
+    lod.SetEnabled(true);
+}
@@ -0,0 +1,123 @@
+/**
+ * @file MachineAnalyticTest.cpp
+ * @author Shane Carr
+ */
+
+#include "pch.h"
+#include "gtest/gtest.h"
+
+#include <MachineSystem.h>
+#include <Machine.h>
+#include <Crank.h>
+#include <Cam.h>
+#include <Box.h>
+
+/**
+ * Find the first component of a type in a machine
+ * @tparam T Component type
+ * @param machine Machine to search
+ * @return Component or null
+ */
+template <class T>
+static std::shared_ptr<T> Find(std::shared_ptr<Machine> machine)
+{
+    for (auto component : machine->GetComponents())
+    {
+        if (auto found = std::dynamic_pointer_cast<T>(component))
+        {
+            return found;
+        }
+    }
+
+    return nullptr;
+}
+
+TEST(MachineAnalyticTest, Evaluate)
+{
+    MachineSystem system(L".");
+    system.SetFrameRate(30);
+    system.SetCheckpointInterval(0);
+
+    auto crank = Find<Crank>(system.GetMachine());
+    ASSERT_NE(nullptr, crank);
+    ASSERT_TRUE(crank->IsAnalytic());
+    ASSERT_FALSE(Find<Box>(system.GetMachine())->IsAnalytic());
+
+    // The crank is exactly where its speed puts it
+    system.SetMachineFrame(123);
+    ASSERT_DOUBLE_EQ(crank->GetSpeed() * 123 / 30.0, crank->GetRotation());
+
+    system.SetMachineFrame(45);
+    ASSERT_DOUBLE_EQ(crank->GetSpeed() * 45 / 30.0, crank->GetRotation());
+}
+
+TEST(MachineAnalyticTest, KeyFallFrame)
+{
+    MachineSystem system(L".");
+    system.SetFrameRate(30);
+
+    auto cam = Find<Cam>(system.GetMachine());
+    ASSERT_NE(nullptr, cam);
+
+    // The cam turns at an eighth of the crank speed, so the
+    // key drops at 8 seconds
+    system.SetMachineFrame(239);
+    ASSERT_TRUE(cam->HasPendingEvents());
+
+    system.SetMachineFrame(240);
+    ASSERT_FALSE(cam->HasPendingEvents());
+
+    // Once the key has dropped the analytic components are
+    // not evaluated every frame, but still end up in the right place
+    system.SetMachineFrame(900);
+    auto crank = Find<Crank>(system.GetMachine());
+    ASSERT_DOUBLE_EQ(crank->GetSpeed() * 900 / 30.0, crank->GetRotation());
+    ASSERT_DOUBLE_EQ(900 / 30.0, cam->GetTime());
+}
+
+TEST(MachineAnalyticTest, EventSchedule)
+{
+    MachineSystem system(L".");
+    system.SetFrameRate(30);
+    auto machine = system.GetMachine();
+
+    // The key fall is predicted from the crank speed and the
+    // drive ratio, no polling needed
+    ASSERT_FALSE(machine->IsPolling());
+    ASSERT_NEAR(8.0, machine->GetNextEventTime(), 1e-9);
+
+    system.SetMachineFrame(240);
+    ASSERT_TRUE(std::isinf(machine->GetNextEventTime()));
+
+    // Going back brings the event back
+    system.SetMachineFrame(100);
+    ASSERT_NEAR(8.0, machine->GetNextEventTime(), 1e-9);
+}
+
+TEST(MachineAnalyticTest, FastForward)
+{
+    MachineSystem fast(L".");
+    fast.SetFrameRate(30);
+    fast.SetCheckpointInterval(0);
+
+    MachineSystem stepped(L".");
+    stepped.SetFrameRate(30);
+    stepped.SetCheckpointInterval(0);
+    stepped.SetFastForward(false);
+
+    // Up to the key drop, through the lid opening and Sparty
+    // popping, and well into the bounce dying out
+    for (int frame : {200, 239, 240, 245, 260, 1800})
+    {
+        fast.SetMachineFrame(frame);
+        stepped.SetMachineFrame(frame);
+
+        MachineSnapshot fastState, steppedState;
+        fast.GetMachine()->SaveState(fastState);
+        stepped.GetMachine()->SaveState(steppedState);
+        ASSERT_EQ(steppedState, fastState) << "frame " << frame;
+    }
+
+    ASSERT_EQ(0, stepped.GetFastForwardedFrames());
+    ASSERT_GT(fast.GetFastForwardedFrames(), 1700);
+}
@@ -0,0 +1,131 @@
+/**
+ * @file MachineCheckpointTest.cpp
+ * @author Shane Carr
+ */
+
+#include "pch.h"
+#include "gtest/gtest.h"
+
+#include <MachineSystem.h>
+#include <Machine.h>
+
+/**
+ * Get the full state of a machine system's machine
+ * @param system System to look at
+ * @return Saved state
+ */
+static MachineSnapshot StateOf(const MachineSystem &system)
+{
+    MachineSnapshot state;
+    system.GetMachine()->SaveState(state);
+    return state;
+}
+
+TEST(MachineCheckpointTest, SeekMatchesStepping)
+{
+    MachineSystem system(L".");
+    system.SetFrameRate(30);
+    system.SetCheckpointInterval(30);
+
+    // Past the cam key drop, so the box and Sparty are moving
+    system.SetMachineFrame(400);
+    ASSERT_GT(system.GetCheckpointCount(), 0u);
+
+    for (int frame : {250, 30, 399, 0, 271})
+    {
+        system.SetMachineFrame(frame);
+
+        MachineSystem fresh(L".");
+        fresh.SetFrameRate(30);
+        fresh.SetCheckpointInterval(0);
+        fresh.SetMachineFrame(frame);
+
+        ASSERT_EQ(StateOf(fresh), StateOf(system)) << "frame " << frame;
+        ASSERT_NEAR(frame / 30.0, system.GetMachineTime(), 0.0001);
+    }
+}
+
+TEST(MachineCheckpointTest, SeekCost)
+{
+    MachineSystem with(L".");
+    with.SetFrameRate(30);
+    with.SetCheckpointInterval(30);
+    with.SetMachineFrame(600);
+
+    MachineSystem without(L".");
+    without.SetFrameRate(30);
+    without.SetCheckpointInterval(0);
+    without.SetMachineFrame(600);
+
+    // Scrub back a little, the cost is known beforehand
+    ASSERT_EQ(20, with.GetSeekFrames(590));
+    auto before = with.GetSteppedFrames();
+    with.SetMachineFrame(590);
+    ASSERT_LT(with.GetSteppedFrames() - before, 30);
+    ASSERT_EQ(20, with.GetSteppedFrames() - before);
+
+    ASSERT_EQ(590, without.GetSeekFrames(590));
+    before = without.GetSteppedFrames();
+    without.SetMachineFrame(590);
+    ASSERT_EQ(590, without.GetSteppedFrames() - before);
+
+    // Forward from where we are
+    ASSERT_EQ(10, with.GetSeekFrames(600));
+}
+
+TEST(MachineCheckpointTest, Budget)
+{
+    MachineSystem system(L".");
+    system.SetFrameRate(30);
+    system.SetCheckpointInterval(10);
+
+    size_t bytes = StateOf(system).size();
+
+    // Room for only four checkpoints
+    system.SetCheckpointBudget(bytes * 4);
+    system.SetMachineFrame(300);
+
+    ASSERT_LE(system.GetCheckpointBytes(), bytes * 4);
+    ASSERT_GT(system.GetCheckpointSpacing(), 10);
+    ASSERT_GT(system.GetCheckpointCount(), 0u);
+}
+
+TEST(MachineCheckpointTest, BudgetTooSmall)
+{
+    MachineSystem system(L".");
+    system.SetFrameRate(30);
+    system.SetCheckpointInterval(10);
+
+    size_t bytes = StateOf(system).size();
+
+    // Not even one fits, so none are saved
+    system.SetCheckpointBudget(bytes - 1);
+    system.SetMachineFrame(100);
+    ASSERT_EQ(0u, system.GetCheckpointCount());
+
+    // The interval is kept, a big enough budget brings them back
+    system.SetCheckpointBudget(bytes * 100);
+    system.SetMachineFrame(200);
+    ASSERT_GT(system.GetCheckpointCount(), 0u);
+    ASSERT_EQ(10, system.GetCheckpointSpacing());
+}
+
+TEST(MachineCheckpointTest, SnapshotCopiesBlock)
+{
+    MachineSystem source(L".");
+    source.SetFrameRate(30);
+    source.SetMachineFrame(300);
+
+    // The snapshot is the state block, byte for byte
+    auto snapshot = StateOf(source);
+    const auto &block = source.GetMachine()->GetState();
+    ASSERT_EQ(block.GetSize(), snapshot.size());
+    ASSERT_EQ(0, memcmp(block.GetData(), snapshot.data(), snapshot.size()));
+
+    // Another instance of the same machine takes it as is
+    MachineSystem copy(L".");
+    copy.SetFrameRate(30);
+    copy.GetMachine()->RestoreState(snapshot);
+    ASSERT_EQ(snapshot, StateOf(copy));
+    ASSERT_DOUBLE_EQ(10.0, copy.GetMachine()->GetTime());
+}
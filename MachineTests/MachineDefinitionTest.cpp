@@ -0,0 +1,67 @@
+/**
+ * @file MachineDefinitionTest.cpp
+ * @author Shane Carr
+ */
+
+#include "pch.h"
+#include "gtest/gtest.h"
+
+#include <thread>
+
+#include <MachineSystem.h>
+#include <Machine.h>
+#include <Crank.h>
+
+/**
+ * Get the crank rotation of a machine
+ * @param machine Machine to look in
+ * @return Rotation in turns
+ */
+static double CrankRotation(std::shared_ptr<Machine> machine)
+{
+    auto binding = machine->Bind();
+    for (auto component : machine->GetComponents())
+    {
+        if (auto crank = std::dynamic_pointer_cast<Crank>(component))
+        {
+            return crank->GetRotation();
+        }
+    }
+
+    return 0;
+}
+
+TEST(MachineDefinitionTest, SharedBetweenMachines)
+{
+    MachineSystem first(L".");
+    MachineSystem second(L".");
+
+    auto machine1 = first.GetMachine();
+    auto machine2 = second.GetMachine();
+
+    // Same components, a state block each
+    ASSERT_EQ(machine1->GetDefinition(), machine2->GetDefinition());
+    ASSERT_EQ(machine1->GetComponents()[0], machine2->GetComponents()[0]);
+    ASSERT_NE(&machine1->GetState(), &machine2->GetState());
+
+    first.SetMachineFrame(300);
+    ASSERT_DOUBLE_EQ(0, machine2->GetTime());
+    ASSERT_GT(CrankRotation(machine1), 0);
+    ASSERT_DOUBLE_EQ(0, CrankRotation(machine2));
+
+    second.SetMachineFrame(300);
+    ASSERT_EQ(machine1->GetState().Hash(), machine2->GetState().Hash());
+}
+
+TEST(MachineDefinitionTest, NotSharedBetweenThreads)
+{
+    MachineSystem system(L".");
+
+    std::shared_ptr<MachineDefinition> other;
+    std::thread([&other] {
+        MachineSystem system(L".");
+        other = system.GetMachine()->GetDefinition();
+    }).join();
+
+    ASSERT_NE(system.GetMachine()->GetDefinition(), other);
+}
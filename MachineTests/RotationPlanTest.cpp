@@ -0,0 +1,75 @@
+/**
+ * @file RotationPlanTest.cpp
+ * @author Shane Carr
+ */
+
+#include "pch.h"
+#include "gtest/gtest.h"
+
+#include <Crank.h>
+#include <Shaft.h>
+#include <Pulley.h>
+
+TEST(RotationPlanTest, Compile)
+{
+    Crank crank;
+    Shaft shaft(50);
+    Pulley small(10);
+    Pulley large(40);
+    Shaft output(50);
+
+    crank.GetSource()->AddSink(&shaft);
+    shaft.GetSource()->AddSink(&small);
+    small.BeltTo(&large);
+    large.GetSource()->AddSink(&output);
+
+    std::vector<std::wstring> errors;
+    ASSERT_TRUE(crank.GetSource()->Compile(errors));
+    ASSERT_TRUE(errors.empty());
+
+    // Drivers come before what they drive, with cumulative ratios
+    const auto &plan = crank.GetSource()->GetPlan();
+    ASSERT_EQ(4u, plan.size());
+    ASSERT_EQ(&shaft, plan[0].first);
+    ASSERT_EQ(&output, plan[3].first);
+    ASSERT_DOUBLE_EQ(0.25, plan[3].second);
+
+    crank.Evaluate(2);
+    ASSERT_DOUBLE_EQ(2, shaft.GetRotation());
+    ASSERT_DOUBLE_EQ(0.5, large.GetRotation());
+    ASSERT_DOUBLE_EQ(0.5, output.GetRotation());
+}
+
+TEST(RotationPlanTest, Cycle)
+{
+    Crank crank;
+    Pulley a(10);
+    Pulley b(20);
+
+    crank.GetSource()->AddSink(&a);
+    a.BeltTo(&b);
+    b.BeltTo(&a);
+
+    std::vector<std::wstring> errors;
+    ASSERT_FALSE(crank.GetSource()->Compile(errors));
+    ASSERT_EQ(1u, errors.size());
+    ASSERT_FALSE(crank.GetSource()->IsCompiled());
+}
+
+TEST(RotationPlanTest, Conflict)
+{
+    Crank crank;
+    Shaft shaft(50);
+    Pulley a(10);
+    Pulley b(20);
+
+    // b is turned by both the shaft and the belt from a
+    crank.GetSource()->AddSink(&shaft);
+    shaft.GetSource()->AddSink(&a);
+    shaft.GetSource()->AddSink(&b);
+    a.BeltTo(&b);
+
+    std::vector<std::wstring> errors;
+    ASSERT_FALSE(crank.GetSource()->Compile(errors));
+    ASSERT_FALSE(errors.empty());
+}
@@ -0,0 +1,212 @@
+/**
+ * @file SoftwareRasterizerTest.cpp
+ * @author Shane Carr
+ */
+
+#include "pch.h"
+#include "gtest/gtest.h"
+
+#include <SoftwareRasterizer.h>
+#include <Polygon.h>
+#include <MachineSystem.h>
+
+/// Size of the frames we compare
+const int FrameSize = 100;
+
+/**
+ * Mean absolute difference between two images of the same size
+ * @param a First image
+ * @param b Second image
+ * @return Mean difference per channel, 0 to 255
+ */
+static double MeanDifference(const wxImage &a, const wxImage &b)
+{
+    size_t bytes = size_t(a.GetWidth()) * a.GetHeight() * 3;
+    double total = 0;
+    for (size_t i = 0; i < bytes; i++)
+    {
+        total += abs(int(a.GetData()[i]) - int(b.GetData()[i]));
+    }
+
+    return total / bytes;
+}
+
+/**
+ * Make a test image with a color gradient and an alpha ramp
+ * @return Shared image
+ */
+static std::shared_ptr<const wxImage> MakeImage()
+{
+    auto image = std::make_shared<wxImage>(32, 24, false);
+    image->InitAlpha();
+    for (int y = 0; y < image->GetHeight(); y++)
+    {
+        for (int x = 0; x < image->GetWidth(); x++)
+        {
+            image->SetRGB(x, y, x * 8, y * 10, 128);
+            image->SetAlpha(x, y, y < 4 ? 0 : 255 - x * 4);
+        }
+    }
+
+    return image;
+}
+
+TEST(SoftwareRasterizerTest, Fill)
+{
+    SoftwareRasterizer rasterizer(20, 20);
+    rasterizer.Clear(*wxWHITE);
+
+    rasterizer.FillPolygon({wxPoint2DDouble(2, 2), wxPoint2DDouble(12, 2),
+                            wxPoint2DDouble(12, 12), wxPoint2DDouble(2, 12)}, *wxRED);
+
+    // Inside, outside and just past the right edge
+    ASSERT_EQ(0xff0000ffu, rasterizer.GetPixel(5, 5));
+    ASSERT_EQ(0xffffffffu, rasterizer.GetPixel(1, 1));
+    ASSERT_EQ(0xffffffffu, rasterizer.GetPixel(12, 5));
+
+    // Half opacity over a half covered pixel is a quarter
+    rasterizer.FillPolygon({wxPoint2DDouble(2.5, 14), wxPoint2DDouble(10, 14),
+                            wxPoint2DDouble(10, 16), wxPoint2DDouble(2.5, 16)}, *wxBLUE, 0.5);
+    ASSERT_EQ(0xffff7f7fu, rasterizer.GetPixel(5, 15));
+    ASSERT_EQ(0xffffbfbfu, rasterizer.GetPixel(2, 15));
+}
+
+TEST(SoftwareRasterizerTest, Transform)
+{
+    SoftwareRasterizer rasterizer(20, 20);
+    rasterizer.Clear(*wxWHITE);
+
+    // A quarter turn maps +x onto +y on the screen
+    rasterizer.Translate(10, 10);
+    rasterizer.Rotate(M_PI / 2);
+    rasterizer.FillPolygon({wxPoint2DDouble(1, -1), wxPoint2DDouble(6, -1),
+                            wxPoint2DDouble(6, 1), wxPoint2DDouble(1, 1)}, *wxBLACK);
+
+    ASSERT_EQ(0xff000000u, rasterizer.GetPixel(10, 14));
+    ASSERT_EQ(0xffffffffu, rasterizer.GetPixel(14, 10));
+    ASSERT_EQ(0xffffffffu, rasterizer.GetPixel(10, 6));
+}
+
+TEST(SoftwareRasterizerTest, MatchesGraphicsContext)
+{
+    auto sprite = MakeImage();
+
+    cse335::Polygon polygon;
+    polygon.Rectangle(-20, -10, 40, 20);
+    polygon.SetColor(wxColour(30, 160, 60));
+    polygon.SetOpacity(0.75);
+
+    // Draw the same scene through wx
+    wxImage expected(FrameSize, FrameSize, false);
+    memset(expected.GetData(), 255, size_t(FrameSize) * FrameSize * 3);
+    {
+        auto graphics = std::shared_ptr<wxGraphicsContext>(wxGraphicsContext::Create(expected));
+        graphics->PushState();
+        graphics->Translate(30, 35);
+        graphics->Rotate(0.4);
+        graphics->DrawBitmap(graphics->CreateBitmapFromImage(*sprite), -16, -12, 32, 24);
+        graphics->PopState();
+
+        polygon.DrawPolygon(graphics, 60, 70, 0.1);
+    }
+
+    // And through the rasterizer
+    SoftwareRasterizer rasterizer(FrameSize, FrameSize);
+    rasterizer.Clear(*wxWHITE);
+    rasterizer.PushState();
+    rasterizer.Translate(30, 35);
+    rasterizer.Rotate(0.4);
+    rasterizer.DrawImage(sprite, -16, -12, 32, 24);
+    rasterizer.PopState();
+
+    std::vector<wxPoint2DDouble> points = {{-20, -10}, {20, -10}, {20, 10}, {-20, 10}};
+    rasterizer.PushState();
+    rasterizer.Translate(60, 70);
+    rasterizer.Rotate(0.1 * M_PI * 2);
+    rasterizer.FillPolygon(points, wxColour(30, 160, 60), 0.75);
+    rasterizer.PopState();
+
+    // Antialiasing and filtering differ a little at the edges
+    ASSERT_LT(MeanDifference(expected, rasterizer.GetImage()), 3.0);
+}
+
+TEST(SoftwareRasterizerTest, Clip)
+{
+    SoftwareRasterizer rasterizer(20, 20);
+    rasterizer.Clear(*wxWHITE);
+
+    std::vector<wxPoint2DDouble> square = {{0, 0}, {20, 0}, {20, 20}, {0, 20}};
+
+    // Only the lower left triangle of the square is filled
+    rasterizer.PushState();
+    rasterizer.Clip({wxPoint2DDouble(0, 0), wxPoint2DDouble(20, 20), wxPoint2DDouble(0, 20)});
+    rasterizer.FillPolygon(square, *wxRED);
+
+    ASSERT_EQ(0xff0000ffu, rasterizer.GetPixel(3, 15));
+    ASSERT_EQ(0xffffffffu, rasterizer.GetPixel(15, 3));
+
+    // Clips intersect
+    rasterizer.Clip({wxPoint2DDouble(0, 10), wxPoint2DDouble(20, 10), wxPoint2DDouble(20, 20), wxPoint2DDouble(0, 20)});
+    rasterizer.FillPolygon(square, *wxBLUE);
+
+    ASSERT_EQ(0xffff0000u, rasterizer.GetPixel(3, 15));
+    ASSERT_EQ(0xff0000ffu, rasterizer.GetPixel(3, 5));
+    ASSERT_EQ(0xffffffffu, rasterizer.GetPixel(15, 13));
+
+    // Images are clipped too
+    rasterizer.DrawImage(MakeImage(), 0, 0, 20, 20);
+    ASSERT_EQ(0xffffffffu, rasterizer.GetPixel(15, 13));
+
+    // Popping the state restores no clip
+    rasterizer.PopState();
+    rasterizer.FillPolygon(square, *wxBLACK);
+    ASSERT_EQ(0xff000000u, rasterizer.GetPixel(15, 3));
+}
+
+TEST(SoftwareRasterizerTest, ImagePolygonMatchesGraphicsContext)
+{
+    // A triangle, so the image has to be clipped to the shape
+    cse335::Polygon polygon;
+    polygon.AddPoint(-30, -30);
+    polygon.AddPoint(30, -30);
+    polygon.AddPoint(-30, 30);
+    polygon.SetImage(L"images/key.png");
+
+    wxImage expected(FrameSize, FrameSize, false);
+    memset(expected.GetData(), 255, size_t(FrameSize) * FrameSize * 3);
+    {
+        auto graphics = std::shared_ptr<wxGraphicsContext>(wxGraphicsContext::Create(expected));
+        polygon.DrawPolygon(graphics, 50, 50, 0.05);
+    }
+
+    SoftwareRasterizer rasterizer(FrameSize, FrameSize);
+    rasterizer.Clear(*wxWHITE);
+    polygon.Rasterize(rasterizer, 50, 50, 0.05);
+
+    ASSERT_LT(MeanDifference(expected, rasterizer.GetImage()), 3.0);
+}
+
+TEST(SoftwareRasterizerTest, MachineMatchesGraphicsContext)
+{
+    const int MachineFrameSize = 500;
+
+    MachineSystem system(L".");
+    system.SetLocation(wxPoint(250, 450));
+    system.SetFrameRate(30);
+
+    // Past the cam key drop, so Sparty is out of the box
+    system.SetMachineFrame(400);
+
+    wxImage expected(MachineFrameSize, MachineFrameSize, false);
+    memset(expected.GetData(), 255, size_t(MachineFrameSize) * MachineFrameSize * 3);
+    {
+        auto graphics = std::shared_ptr<wxGraphicsContext>(wxGraphicsContext::Create(expected));
+        system.DrawMachine(graphics);
+    }
+
+    SoftwareRasterizer rasterizer(MachineFrameSize, MachineFrameSize);
+    rasterizer.Clear(*wxWHITE);
+    system.RasterizeMachine(rasterizer);
+
+    ASSERT_LT(MeanDifference(expected, rasterizer.GetImage()), 3.0);
+}
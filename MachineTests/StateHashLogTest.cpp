@@ -0,0 +1,93 @@
+/**
+ * @file StateHashLogTest.cpp
+ * @author Shane Carr
+ */
+
+#include "pch.h"
+#include "gtest/gtest.h"
+
+#include <optional>
+#include <sstream>
+
+#include <MachineSystem.h>
+#include <StateHashLog.h>
+
+TEST(StateHashLogTest, ShortcutsMatchReplay)
+{
+    MachineSystem system(L".");
+    system.SetFrameRate(30);
+    system.SetCheckpointInterval(30);
+    system.StartHashLog();
+
+    // Fast forwards, checkpoint restores and plain steps, across
+    // the key drop and back
+    for (int frame : {400, 250, 30, 399, 0, 271, 272, 900})
+    {
+        system.SetMachineFrame(frame);
+    }
+
+    auto log = system.GetHashLog();
+    ASSERT_NE(nullptr, log);
+    ASSERT_EQ(900, log->GetEntries().back().frame);
+    ASSERT_EQ(StateHashLog::NoDivergence, log->FindDivergence(L"."));
+}
+
+TEST(StateHashLogTest, ReportsFirstDivergence)
+{
+    MachineSystem system(L".");
+    system.SetFrameRate(30);
+
+    // Step every frame so every frame is logged
+    system.SetFastForward(false);
+    system.SetCheckpointInterval(0);
+    system.StartHashLog();
+    system.SetMachineFrame(100);
+
+    auto log = system.GetHashLog();
+    auto hashAt = [log](int frame) {
+        for (const auto &entry : log->GetEntries())
+        {
+            if (entry.frame == frame)
+            {
+                return std::optional<uint64_t>(entry.hash);
+            }
+        }
+
+        return std::optional<uint64_t>();
+    };
+
+    auto hash50 = hashAt(50);
+    auto hash21 = hashAt(21);
+    ASSERT_TRUE(hash50.has_value());
+    ASSERT_TRUE(hash21.has_value());
+
+    // A frame that did not end up in the state it should have
+    log->Add(50, *hash50 + 1);
+    log->Add(20, *hash21);
+
+    ASSERT_EQ(50, log->FindDivergence(L"."));
+}
+
+TEST(StateHashLogTest, SaveLoad)
+{
+    StateHashLog log(2, 24);
+    log.Add(0, 0x0123456789abcdefull);
+    log.Add(7, 42);
+
+    std::stringstream stream;
+    ASSERT_TRUE(log.Save(stream));
+
+    // 12 bytes an entry after the header
+    ASSERT_EQ(4 + 4 + 4 + 8 + 8 + 2 * 12, int(stream.str().size()));
+
+    auto loaded = StateHashLog::Load(stream);
+    ASSERT_NE(nullptr, loaded);
+    ASSERT_EQ(2, loaded->GetMachineNumber());
+    ASSERT_EQ(24.0, loaded->GetFrameRate());
+    ASSERT_EQ(2u, loaded->GetEntries().size());
+    ASSERT_EQ(7, loaded->GetEntries()[1].frame);
+    ASSERT_EQ(0x0123456789abcdefull, loaded->GetEntries()[0].hash);
+
+    std::stringstream junk("not a log");
+    ASSERT_EQ(nullptr, StateHashLog::Load(junk));
+}
@@ -0,0 +1,53 @@
+/**
+ * @file FrameProfilerTest.cpp
+ * @author Shane Carr
+ */
+
+#include <pch.h>
+#include "gtest/gtest.h"
+
+#include <FrameProfiler.h>
+
+using namespace std::chrono;
+
+TEST(FrameProfilerTest, Percentiles)
+{
+    FrameProfiler profiler;
+    ASSERT_EQ(0, profiler.Percentile(FrameProfiler::Stage::Render, 50));
+
+    // 1 to 100 ms
+    for (int i = 1; i <= 100; i++)
+    {
+        profiler.Add(FrameProfiler::Stage::Render, milliseconds(i));
+    }
+
+    ASSERT_NEAR(51, profiler.Percentile(FrameProfiler::Stage::Render, 50), 0.001);
+    ASSERT_NEAR(99, profiler.Percentile(FrameProfiler::Stage::Render, 99), 0.001);
+
+    auto stats = profiler.GetStats();
+    ASSERT_EQ(size_t(FrameProfiler::Stage::Count), stats.size());
+    ASSERT_EQ(L"Render", stats[int(FrameProfiler::Stage::Render)].name);
+    ASSERT_EQ(100, stats[int(FrameProfiler::Stage::Render)].count);
+    ASSERT_EQ(0, stats[int(FrameProfiler::Stage::Timeline)].count);
+
+    // Only the most recent samples are kept
+    for (int i = 0; i < FrameProfiler::Window; i++)
+    {
+        profiler.Add(FrameProfiler::Stage::Render, milliseconds(2));
+    }
+
+    ASSERT_NEAR(2, profiler.Percentile(FrameProfiler::Stage::Render, 99), 0.001);
+
+    profiler.Clear();
+    ASSERT_EQ(0, profiler.GetStats()[int(FrameProfiler::Stage::Render)].count);
+}
+
+TEST(FrameProfilerTest, Scope)
+{
+    FrameProfiler profiler;
+    {
+        FrameProfiler::Scope scope(profiler, FrameProfiler::Stage::Place);
+    }
+
+    ASSERT_EQ(1, profiler.GetStats()[int(FrameProfiler::Stage::Place)].count);
+}
@@ -0,0 +1,59 @@
+/**
+ * @file ImageAtlasTest.cpp
+ * @author Shane Carr
+ */
+
+#include <pch.h>
+#include "gtest/gtest.h"
+
+#include <ImageAtlas.h>
+
+TEST(ImageAtlasTest, Pack)
+{
+    wxBitmap bitmap(100, 100);
+    wxMemoryDC dc(bitmap);
+    auto graphics = std::shared_ptr<wxGraphicsContext>(wxGraphicsContext::Create( dc ));
+
+    ImageAtlas atlas(256);
+
+    std::vector<int> entries;
+    for (int i = 0; i < 6; i++)
+    {
+        wxImage image(60 + i * 5, 40 + i * 10);
+        entries.push_back(atlas.Add(image));
+        ASSERT_EQ(i, entries.back());
+    }
+
+    // Too big to ever fit on a page
+    wxImage huge(300, 10);
+    ASSERT_EQ(-1, atlas.Add(huge));
+
+    atlas.Build(graphics);
+    ASSERT_TRUE(atlas.IsBuilt());
+    ASSERT_EQ(1, atlas.GetPageCount());
+    ASSERT_EQ(1, atlas.GetUploads());
+
+    // Every entry is on the page and none overlap
+    for (auto a : entries)
+    {
+        auto ra = atlas.GetRect(a);
+        ASSERT_EQ(60 + a * 5, ra.GetWidth());
+        ASSERT_EQ(40 + a * 10, ra.GetHeight());
+        ASSERT_TRUE(wxRect(0, 0, 256, 256).Contains(ra));
+
+        // Everything draws from the one page bitmap
+        ASSERT_EQ(&atlas.GetBitmap(entries[0]), &atlas.GetBitmap(a));
+        for (auto b : entries)
+        {
+            if (a != b)
+            {
+                ASSERT_FALSE(ra.Intersects(atlas.GetRect(b)));
+            }
+        }
+    }
+
+    // Building again does not upload again, and it's too late to add
+    atlas.Build(graphics);
+    ASSERT_EQ(1, atlas.GetUploads());
+    ASSERT_EQ(-1, atlas.Add(wxImage(10, 10)));
+}
@@ -0,0 +1,120 @@
+/**
+ * @file LayerCacheTest.cpp
+ * @author Shane Carr
+ */
+
+#include <pch.h>
+#include "gtest/gtest.h"
+
+#include <LayerCache.h>
+#include <RenderCommandList.h>
+#include <PolyDrawable.h>
+#include <Actor.h>
+
+/**
+ * Create an actor that is a single square
+ * @param name Actor name
+ * @param position Actor position
+ * @return New actor
+ */
+static std::shared_ptr<Actor> MakeActor(const std::wstring &name, wxPoint position)
+{
+    auto actor = std::make_shared<Actor>(name);
+    actor->SetPosition(position);
+
+    auto poly = std::make_shared<PolyDrawable>(name);
+    poly->SetColor(*wxRED);
+    poly->AddPoint(wxPoint(0, 0));
+    poly->AddPoint(wxPoint(50, 0));
+    poly->AddPoint(wxPoint(50, 50));
+    poly->AddPoint(wxPoint(0, 50));
+
+    actor->AddDrawable(poly);
+    actor->SetRoot(poly);
+    return actor;
+}
+
+/**
+ * Place all of the actors, as Picture::Draw does
+ * @param actors Actors to place
+ */
+static void PlaceAll(const std::vector<std::shared_ptr<Actor>> &actors)
+{
+    for (auto actor : actors)
+    {
+        actor->Place();
+    }
+}
+
+TEST(LayerCacheTest, StaticActors)
+{
+    wxBitmap bitmap(1000, 1000);
+    wxMemoryDC dc(bitmap);
+    auto graphics = std::shared_ptr<wxGraphicsContext>(wxGraphicsContext::Create( dc ));
+
+    std::vector<std::shared_ptr<Actor>> actors;
+    actors.push_back(MakeActor(L"Back", wxPoint(100, 100)));
+    actors.push_back(MakeActor(L"Middle", wxPoint(200, 100)));
+    actors.push_back(MakeActor(L"Front", wxPoint(300, 100)));
+
+    LayerCache cache;
+    RenderCommandList commands;
+
+    // Nothing is known to be static on the first draw
+    commands.Begin(graphics);
+    PlaceAll(actors);
+    cache.Record(commands, actors, wxSize(1000, 1000));
+    ASSERT_EQ(0, cache.GetLayerCount());
+    ASSERT_EQ(3, commands.GetCommands().size());
+
+    // Nothing moved, so everything is one layer
+    commands.Begin(graphics);
+    PlaceAll(actors);
+    cache.Record(commands, actors, wxSize(1000, 1000));
+    ASSERT_EQ(1, cache.GetLayerCount());
+    ASSERT_EQ(1, cache.GetBuilds());
+    ASSERT_EQ(1, commands.GetCommands().size());
+    ASSERT_EQ(RenderCommandList::Kind::Bitmap, commands.GetCommands()[0].kind);
+
+    // The layer is reused
+    commands.Begin(graphics);
+    PlaceAll(actors);
+    cache.Record(commands, actors, wxSize(1000, 1000));
+    ASSERT_EQ(1, cache.GetBuilds());
+    ASSERT_EQ(1, cache.GetHits());
+
+    // Moving the middle actor splits the layer in two,
+    // drawn on either side of it
+    actors[1]->SetPosition(wxPoint(200, 300));
+    commands.Begin(graphics);
+    PlaceAll(actors);
+    cache.Record(commands, actors, wxSize(1000, 1000));
+    ASSERT_EQ(2, cache.GetLayerCount());
+    ASSERT_EQ(3, cache.GetBuilds());
+    ASSERT_EQ(3, commands.GetCommands().size());
+    ASSERT_EQ(RenderCommandList::Kind::Bitmap, commands.GetCommands()[0].kind);
+    ASSERT_EQ(RenderCommandList::Kind::Fill, commands.GetCommands()[1].kind);
+    ASSERT_EQ(RenderCommandList::Kind::Bitmap, commands.GetCommands()[2].kind);
+
+    // Invalidating forgets everything
+    cache.Invalidate();
+    ASSERT_EQ(0, cache.GetLayerCount());
+}
+
+TEST(LayerCacheTest, SignatureOffScreen)
+{
+    auto actor = MakeActor(L"Actor", wxPoint(-100, -50));
+    actor->Place();
+    auto signature = LayerCache::Signature(actor.get());
+    ASSERT_EQ(signature, LayerCache::Signature(actor.get()));
+
+    // Moving a pixel up and to the left still changes it
+    actor->SetPosition(wxPoint(-101, -50));
+    actor->Place();
+    auto left = LayerCache::Signature(actor.get());
+    ASSERT_NE(signature, left);
+
+    actor->SetPosition(wxPoint(-101, -51));
+    actor->Place();
+    ASSERT_NE(left, LayerCache::Signature(actor.get()));
+}
@@ -0,0 +1,58 @@
+/**
+ * @file PlaybackClockTest.cpp
+ * @author Shane Carr
+ */
+
+#include <pch.h>
+#include "gtest/gtest.h"
+
+#include <PlaybackClock.h>
+
+using namespace std::chrono;
+
+TEST(PlaybackClockTest, OnTime)
+{
+    PlaybackClock clock;
+    auto start = PlaybackClock::Clock::now();
+    clock.Start(10, 30, start);
+
+    // Nothing is due before the next frame
+    ASSERT_EQ(0, clock.Advance(start + milliseconds(20)));
+    ASSERT_EQ(10, clock.GetFrame());
+
+    // Deadlines are computed from the start, so they do not drift
+    for (int i = 1; i <= 300; i++)
+    {
+        auto deadline = start + duration_cast<PlaybackClock::Clock::duration>(duration<double>(i / 30.0));
+        ASSERT_EQ(1, clock.Advance(deadline));
+        ASSERT_EQ(10 + i, clock.GetFrame());
+    }
+
+    ASSERT_EQ(0, clock.GetDroppedFrames());
+    ASSERT_EQ(300, clock.GetPresentedFrames());
+    ASSERT_NEAR(0, clock.GetMaxLateness(), 0.01);
+    ASSERT_NEAR(30, clock.GetFps(), 0.01);
+}
+
+TEST(PlaybackClockTest, Behind)
+{
+    PlaybackClock clock;
+    auto start = PlaybackClock::Clock::now();
+    clock.Start(0, 10, start);
+
+    // 350ms in, frame 3 is due and 1 and 2 were missed
+    ASSERT_EQ(3, clock.Advance(start + milliseconds(350)));
+    ASSERT_EQ(3, clock.GetFrame());
+    ASSERT_EQ(2, clock.GetDroppedFrames());
+    ASSERT_NEAR(50, clock.GetLateness()[0], 0.01);
+    ASSERT_NEAR(0.3, clock.GetTime(), 1e-9);
+
+    // The next frame is due at 400ms
+    auto wait = clock.UntilNext(start + milliseconds(350));
+    ASSERT_EQ(50, duration_cast<milliseconds>(wait).count());
+
+    // Restarting resets the statistics
+    clock.Start(0, 10, start);
+    ASSERT_EQ(0, clock.GetDroppedFrames());
+    ASSERT_EQ(0, clock.GetPresentedFrames());
+}
@@ -69,6 +69,114 @@ TEST(PolyDrawableTest, HitTest)
     ASSERT_FALSE(poly1->HitTest(wxPoint(210, 490)));
 }
 
+TEST(PolyDrawableTest, HitTestWithoutDraw)
+{
+    auto actor = std::make_shared<Actor>(L"Square");
+    actor->SetPosition(wxPoint(100, 500));
+
+    auto poly1 = std::make_shared<PolyDrawable>(L"Polygon");
+    poly1->SetPosition(wxPoint(100, 100));
+    poly1->SetRotation(M_PI/2);
+    poly1->AddPoint(wxPoint(0, 0));
+    poly1->AddPoint(wxPoint(100, 0));
+    poly1->AddPoint(wxPoint(100, 100));
+    poly1->AddPoint(wxPoint(0, 100));
+
+    actor->AddDrawable(poly1);
+    actor->SetRoot(poly1);
+
+    // Place without ever drawing
+    poly1->Place(actor->GetPosition(), 0);
+
+    ASSERT_TRUE(poly1->HitTest(wxPoint(210, 590)));
+    ASSERT_FALSE(poly1->HitTest(wxPoint(190, 590)));
+    ASSERT_FALSE(poly1->HitTest(wxPoint(210, 610)));
+    ASSERT_FALSE(poly1->HitTest(wxPoint(310, 590)));
+    ASSERT_FALSE(poly1->HitTest(wxPoint(210, 490)));
+
+    // Moving the drawable must invalidate the edge table
+    poly1->Place(actor->GetPosition() + wxPoint(200, 0), 0);
+    ASSERT_FALSE(poly1->HitTest(wxPoint(210, 590)));
+    ASSERT_TRUE(poly1->HitTest(wxPoint(410, 590)));
+
+    // Concave shape: the notch is outside
+    auto poly2 = std::make_shared<PolyDrawable>(L"Notch");
+    poly2->AddPoint(wxPoint(0, 0));
+    poly2->AddPoint(wxPoint(100, 0));
+    poly2->AddPoint(wxPoint(100, 100));
+    poly2->AddPoint(wxPoint(50, 20));
+    poly2->AddPoint(wxPoint(0, 100));
+    poly2->Place(wxPoint(0, 0), 0);
+
+    ASSERT_TRUE(poly2->HitTest(wxPoint(50, 10)));
+    ASSERT_FALSE(poly2->HitTest(wxPoint(50, 60)));
+    ASSERT_TRUE(poly2->HitTest(wxPoint(10, 60)));
+}
+
+TEST(PolyDrawableTest, HitTestMatchesDrawing)
+{
+    const int size = 400;
+    wxImage image(size, size, false);
+    memset(image.GetData(), 255, size_t(size) * size * 3);
+
+    auto poly = std::make_shared<PolyDrawable>(L"Polygon");
+    poly->SetColor(wxColour(255, 0, 0));
+    poly->AddPoint(wxPoint(0, 0));
+    poly->AddPoint(wxPoint(150, 20));
+    poly->AddPoint(wxPoint(120, 130));
+    poly->AddPoint(wxPoint(-30, 90));
+
+    // An angle where the placed vertices are not whole pixels
+    poly->Place(wxPoint(150, 120), 0.37);
+    {
+        auto graphics = std::shared_ptr<wxGraphicsContext>(wxGraphicsContext::Create(image));
+        poly->Draw(graphics);
+    }
+
+    // Every pixel that is fully drawn must hit and every pixel
+    // left untouched must miss. Antialiased edge pixels can go
+    // either way.
+    int checked = 0;
+    for (int y = 0; y < size; y++)
+    {
+        for (int x = 0; x < size; x++)
+        {
+            auto green = image.GetGreen(x, y);
+            if (green == 0 || green == 255)
+            {
+                ASSERT_EQ(green == 0, poly->HitTest(wxPoint(x, y)));
+                checked++;
+            }
+        }
+    }
+
+    ASSERT_GT(checked, size * size * 9 / 10);
+}
+
+TEST(PolyDrawableTest, BoundingBox)
+{
+    auto poly = std::make_shared<PolyDrawable>(L"Polygon");
+    ASSERT_TRUE(poly->GetBoundingBox().IsEmpty());
+
+    poly->SetRotation(M_PI/2);
+    poly->AddPoint(wxPoint(0, 0));
+    poly->AddPoint(wxPoint(100, 0));
+    poly->AddPoint(wxPoint(100, 100));
+    poly->AddPoint(wxPoint(0, 100));
+    poly->Place(wxPoint(200, 600), 0);
+
+    // The box covers the placed polygon with a little slack
+    auto bounds = poly->GetBoundingBox();
+    ASSERT_TRUE(bounds.Contains(wxPoint(200, 500)));
+    ASSERT_TRUE(bounds.Contains(wxPoint(300, 600)));
+    ASSERT_FALSE(bounds.Contains(wxPoint(190, 590)));
+    ASSERT_FALSE(bounds.Contains(wxPoint(250, 610)));
+
+    // Moving the polygon moves the box
+    poly->Place(wxPoint(400, 600), 0);
+    ASSERT_FALSE(poly->GetBoundingBox().Contains(wxPoint(250, 550)));
+    ASSERT_TRUE(poly->GetBoundingBox().Contains(wxPoint(450, 550)));
+}
 
 /** This tests that the animation of the rotation of a drawable works */
 TEST(PolyDrawableTest, Animation)
@@ -0,0 +1,76 @@
+/**
+ * @file RenderCommandListTest.cpp
+ * @author Shane Carr
+ */
+
+#include <pch.h>
+#include "gtest/gtest.h"
+
+#include <RenderCommandList.h>
+#include <PolyDrawable.h>
+#include <Actor.h>
+
+/**
+ * Create a square polygon drawable
+ * @param name Drawable name
+ * @param position Position of the square
+ * @param color Fill color
+ * @return New drawable
+ */
+static std::shared_ptr<PolyDrawable> MakeSquare(const std::wstring &name, wxPoint position, wxColour color)
+{
+    auto poly = std::make_shared<PolyDrawable>(name);
+    poly->SetPosition(position);
+    poly->SetColor(color);
+    poly->AddPoint(wxPoint(0, 0));
+    poly->AddPoint(wxPoint(50, 0));
+    poly->AddPoint(wxPoint(50, 50));
+    poly->AddPoint(wxPoint(0, 50));
+    return poly;
+}
+
+TEST(RenderCommandListTest, Batching)
+{
+    wxBitmap bitmap(1000, 1000);
+    wxMemoryDC dc(bitmap);
+    auto graphics = std::shared_ptr<wxGraphicsContext>(wxGraphicsContext::Create( dc ));
+
+    auto actor = std::make_shared<Actor>(L"Squares");
+    auto root = MakeSquare(L"Root", wxPoint(0, 0), *wxRED);
+    actor->AddDrawable(root);
+    actor->SetRoot(root);
+
+    // Two more red squares that don't overlap and one blue
+    auto red1 = MakeSquare(L"Red1", wxPoint(100, 0), *wxRED);
+    auto red2 = MakeSquare(L"Red2", wxPoint(200, 0), *wxRED);
+    auto blue = MakeSquare(L"Blue", wxPoint(300, 0), wxColour(0, 0, 255));
+    for (auto poly : {red1, red2, blue})
+    {
+        root->AddChild(poly);
+        actor->AddDrawable(poly);
+    }
+
+    RenderCommandList commands;
+    actor->Place();
+    commands.Begin(graphics);
+    actor->Record(commands);
+
+    // One command per drawable, two distinct brushes
+    ASSERT_EQ(4, commands.GetCommands().size());
+    ASSERT_EQ(2, commands.GetBrushCount());
+
+    commands.Execute();
+
+    // The three red squares fill as one, the blue fills alone
+    ASSERT_EQ(2, commands.GetDrawCalls());
+    ASSERT_EQ(2, commands.GetStateChanges());
+
+    // Overlapping fills must not merge
+    red1->SetPosition(wxPoint(25, 25));
+    actor->Place();
+    commands.Begin(graphics);
+    actor->Record(commands);
+    commands.Execute();
+    ASSERT_EQ(3, commands.GetDrawCalls());
+    ASSERT_EQ(2, commands.GetStateChanges());
+}
@@ -0,0 +1,96 @@
+/**
+ * @file RotatedSpriteCacheTest.cpp
+ * @author Shane Carr
+ */
+
+#include <pch.h>
+#include "gtest/gtest.h"
+
+#include <RotatedSpriteCache.h>
+
+/**
+ * Make an opaque test image, red on the left half and blue on the right
+ * @param wid Image width
+ * @param hit Image height
+ * @return New image
+ */
+static std::shared_ptr<wxImage> MakeImage(int wid, int hit)
+{
+    auto image = std::make_shared<wxImage>(wid, hit);
+    image->InitAlpha();
+    for (int y = 0; y < hit; y++)
+    {
+        for (int x = 0; x < wid; x++)
+        {
+            if (x < wid / 2)
+            {
+                image->SetRGB(x, y, 255, 0, 0);
+            }
+            else
+            {
+                image->SetRGB(x, y, 0, 0, 255);
+            }
+
+            image->SetAlpha(x, y, 255);
+        }
+    }
+
+    return image;
+}
+
+TEST(RotatedSpriteCacheTest, Rotate)
+{
+    auto image = MakeImage(20, 10);
+
+    // No rotation is an exact copy
+    wxPoint topLeft;
+    auto same = RotatedSpriteCache::Rotate(*image, wxPoint(10, 5), 0, topLeft);
+    ASSERT_EQ(wxPoint(-10, -5), topLeft);
+    ASSERT_EQ(20, same.GetWidth());
+    ASSERT_EQ(10, same.GetHeight());
+    ASSERT_EQ(255, same.GetRed(2, 5));
+    ASSERT_EQ(255, same.GetBlue(17, 5));
+    ASSERT_EQ(255, same.GetAlpha(0, 0));
+
+    // A quarter turn, drawn as Rotate(-angle), moves the
+    // left half of the image to the bottom
+    auto quarter = RotatedSpriteCache::Rotate(*image, wxPoint(10, 5), M_PI / 2, topLeft);
+    ASSERT_EQ(10, quarter.GetWidth());
+    ASSERT_EQ(20, quarter.GetHeight());
+    ASSERT_EQ(wxPoint(-5, -10), topLeft);
+    ASSERT_EQ(255, quarter.GetRed(5, 17));
+    ASSERT_EQ(255, quarter.GetBlue(5, 2));
+}
+
+TEST(RotatedSpriteCacheTest, Cache)
+{
+    wxBitmap bitmap(100, 100);
+    wxMemoryDC dc(bitmap);
+    auto graphics = std::shared_ptr<wxGraphicsContext>(wxGraphicsContext::Create( dc ));
+
+    std::shared_ptr<const wxImage> image = MakeImage(20, 10);
+
+    // Room for two 20x20 sprites
+    RotatedSpriteCache cache(360, 20 * 20 * 4 * 2, 32);
+    ASSERT_TRUE(cache.Accepts(*image));
+    ASSERT_FALSE(cache.Accepts(*MakeImage(64, 10)));
+
+    // Angles within the same degree share a sprite
+    auto sprite1 = cache.Get(graphics, image, wxPoint(10, 5), 0.1);
+    auto sprite2 = cache.Get(graphics, image, wxPoint(10, 5), 0.1 + 0.001);
+    ASSERT_EQ(sprite1, sprite2);
+    ASSERT_EQ(1, cache.GetMisses());
+    ASSERT_EQ(1, cache.GetHits());
+
+    // Filling past the limit evicts the least recently used
+    cache.Get(graphics, image, wxPoint(10, 5), 0.5);
+    cache.Get(graphics, image, wxPoint(10, 5), 0.1);
+    cache.Get(graphics, image, wxPoint(10, 5), 0.9);
+    ASSERT_LE(cache.GetBytes(), size_t(20 * 20 * 4 * 2));
+    ASSERT_LE(1, cache.GetEvictions());
+
+    // 0.1 was used more recently than 0.5, so it survived
+    auto hits = cache.GetHits();
+    cache.Get(graphics, image, wxPoint(10, 5), 0.1);
+    ASSERT_EQ(hits + 1, cache.GetHits());
+}
@@ -83,4 +83,22 @@ TEST(TimelineTest, Add)
 
     timeline.AddChannel(&channel);
     ASSERT_EQ(&timeline, channel.GetTimeline());
-}
\ No newline at end of file
+}
+
+TEST(TimelineTest, MachineStartFrames)
+{
+    Timeline timeline;
+
+    // Machines nobody set start right away
+    ASSERT_EQ(0u, timeline.GetMachineStartFrameCount());
+    ASSERT_EQ(0, timeline.GetMachineStartFrame(0));
+
+    timeline.SetMachineStartFrame(2, 45);
+    ASSERT_EQ(3u, timeline.GetMachineStartFrameCount());
+    ASSERT_EQ(0, timeline.GetMachineStartFrame(1));
+    ASSERT_EQ(45, timeline.GetMachineStartFrame(2));
+    ASSERT_EQ(0, timeline.GetMachineStartFrame(7));
+
+    timeline.Clear();
+    ASSERT_EQ(0, timeline.GetMachineStartFrame(2));
+}